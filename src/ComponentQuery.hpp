@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sdk/ReClass.hpp"
+#include "utility/Columns.hpp"
+
+#include "SceneIndex.hpp"
+
+// Pulls a set of fields out of every live component of a type in one pass,
+// laid out as one array per field (structure of arrays).
+//
+// ComponentQuery<float, int32_t> enemies{ "app.ropeway.enemy.EmCommonContext", { "Hp", "State" } };
+// auto& result = enemies.run();
+// auto& hp = result.get<0>();
+//
+// Field names are resolved into bindings once per concrete type, so each row is just the reads.
+template <typename... Fields>
+class ComponentQuery {
+    // std::vector<bool> packs bits, rows filled from different threads would stomp on each other
+    static_assert(!(std::is_same_v<Fields, bool> || ...), "Read bool fields as uint8_t");
+
+public:
+    static constexpr size_t NUM_FIELDS = sizeof...(Fields);
+
+    struct Result {
+        std::vector<REGameObject*> game_objects{};
+        std::vector<REComponent*> components{};
+        utility::columns::Table<Fields...> columns{};
+
+        template <size_t I>
+        auto& get() {
+            return std::get<I>(columns);
+        }
+
+        template <size_t I>
+        const auto& get() const {
+            return std::get<I>(columns);
+        }
+
+        size_t size() const {
+            return components.size();
+        }
+    };
+
+    ComponentQuery(std::string_view type_name, std::array<std::string_view, NUM_FIELDS> field_names)
+        : m_type_name{ type_name },
+        m_type{ m_type_name }
+    {
+        // Own the names (RETypeRef only keeps a view), callers are free to pass temporaries
+        for (size_t i = 0; i < NUM_FIELDS; ++i) {
+            m_field_names[i] = field_names[i];
+        }
+    }
+
+    // Refill the result from the scene index. The returned reference stays valid until the next run.
+    // parallel splits the reads across threads, which only pays off for large sets whose
+    // fields have been switched to direct loads (getters call into the engine).
+    const Result& run(bool parallel = false) {
+        clear();
+
+        auto t = m_type.get();
+
+        if (t == nullptr || g_scene_index == nullptr) {
+            return m_result;
+        }
+
+        // Gather the rows and their bindings serially, the caches aren't meant to be hammered from workers
+        for (auto game_object : g_scene_index->find_game_objects_with(t)) {
+            auto component = utility::re_component::find(game_object, t);
+
+            if (component == nullptr) {
+                continue;
+            }
+
+            m_result.game_objects.push_back(game_object);
+            m_result.components.push_back(component);
+            m_row_bindings.push_back(&get_bindings(utility::re_managed_object::get_type(component)));
+        }
+
+        const auto num_rows = m_result.components.size();
+        const auto num_threads = parallel ? std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), num_rows / MIN_ROWS_PER_THREAD) : 0;
+
+        utility::columns::fill_split(m_result.columns, num_rows, num_threads, [this](size_t row, auto column) {
+            using Field = std::tuple_element_t<decltype(column)::value, std::tuple<Fields...>>;
+
+            auto component = (REManagedObject*)m_result.components[row];
+            return utility::re_managed_object::read_field<Field>((*m_row_bindings[row])[column], component);
+        });
+
+        return m_result;
+    }
+
+    const Result& get_result() const {
+        return m_result;
+    }
+
+private:
+    using Bindings = std::array<const utility::re_managed_object::FieldBinding*, NUM_FIELDS>;
+
+    static constexpr size_t MIN_ROWS_PER_THREAD = 256;
+
+    void clear() {
+        m_result.game_objects.clear();
+        m_result.components.clear();
+        m_row_bindings.clear();
+
+        std::apply([](auto&... column) {
+            (column.clear(), ...);
+        }, m_result.columns);
+    }
+
+    const Bindings& get_bindings(REType* t) {
+        if (auto it = m_bindings.find(t); it != m_bindings.end()) {
+            return it->second;
+        }
+
+        Bindings bindings{};
+
+        for (size_t i = 0; i < NUM_FIELDS; ++i) {
+            bindings[i] = utility::re_managed_object::get_field_binding(t, m_field_names[i]);
+        }
+
+        return m_bindings.emplace(t, bindings).first->second;
+    }
+
+    std::string m_type_name;
+    sdk::RETypeRef m_type;
+    std::array<std::string, NUM_FIELDS> m_field_names{};
+
+    // Per concrete type, derived components get their own bindings
+    std::unordered_map<REType*, Bindings> m_bindings{};
+    std::vector<const Bindings*> m_row_bindings{};
+
+    Result m_result{};
+};
@@ -6,8 +6,10 @@
 #include "utility/Scan.hpp"
 #include "REFramework.hpp"
 #include "sdk/REMath.hpp"
+#include "sdk/REPose.hpp"
 
 #include "FirstPerson.hpp"
+#include "FirstPersonState.hpp"
 
 FirstPerson* g_first_person = nullptr;
 
@@ -165,6 +167,8 @@ void FirstPerson::on_config_save(utility::Config& cfg) {
 
 thread_local bool g_in_player_transform = false;
 thread_local bool g_first_time = true;
+// Only used within one player UpdateTransform, which happens on a single thread
+thread_local Matrix4x4f* g_cached_bone_matrix = nullptr;
 thread_local glm::quat g_old_rotation{};
 
 void FirstPerson::on_pre_update_transform(RETransform* transform) {
@@ -176,8 +180,8 @@ void FirstPerson::on_pre_update_transform(RETransform* transform) {
         return;
     }
 
-    // We need to lock a mutex because these UpdateTransform functions
-    // are called from multiple threads
+    // These UpdateTransform functions are called from multiple threads,
+    // everything shared with the camera callbacks goes through the seqlocks.
     if (transform == m_player_transform) {
         if (!is_first_person_allowed()) {
             return;
@@ -185,11 +189,10 @@ void FirstPerson::on_pre_update_transform(RETransform* transform) {
 
         g_in_player_transform = true;
         g_first_time = true;
-        m_matrix_mutex.lock();
 
         // Update this beforehand so we don't see the player's head disappear when using the inventory
-        m_last_camera_type = utility::re_managed_object::get_field<app::ropeway::camera::CameraControlType>(m_camera_system, "BusyCameraType");
-        m_cached_bone_matrix = nullptr;
+        m_last_camera_type = m_busy_camera_type_field.get(m_camera_system);
+        g_cached_bone_matrix = nullptr;
 
         update_player_transform(m_player_transform);
     }
@@ -226,7 +229,6 @@ void FirstPerson::on_update_transform(RETransform* transform) {
         //transform->angles = *(Vector4f*)&g_old_rotation;
 
         g_in_player_transform = false;
-        m_matrix_mutex.unlock();
     }
 
     if (m_disable_vignette->value() && m_post_effect_controller != nullptr && transform == m_post_effect_controller->ownerGameObject->transform) {
@@ -279,11 +281,13 @@ void FirstPerson::on_update_camera_controller(RopewayPlayerCameraController* con
         return;
     }
 
+    const auto camera_matrix = m_last_camera_matrix.load();
+
     // The following code fixes inaccuracies between the rotation set by the game and what's set in updateCameraTransform
-    controller->worldPosition = m_last_camera_matrix[3];
-    *(glm::quat*)&controller->worldRotation = glm::quat{ m_last_camera_matrix  };
+    controller->worldPosition = camera_matrix[3];
+    *(glm::quat*)&controller->worldRotation = glm::quat{ camera_matrix };
 
-    m_camera->ownerGameObject->transform->worldTransform = m_last_camera_matrix;
+    m_camera->ownerGameObject->transform->worldTransform = camera_matrix;
     m_camera->ownerGameObject->transform->angles = *(Vector4f*)&controller->worldRotation;
 }
 
@@ -295,36 +299,32 @@ void FirstPerson::on_update_camera_controller2(RopewayPlayerCameraController* co
     // Just update the FOV in here. Whatever.
     update_fov(controller);
 
-    if (m_camera_system->cameraController == m_player_camera_controller) {
-        if (m_ignore_next_player_angles) {
-            // keep ignoring player input until no longer switching cameras
-            if (m_ignore_next_player_angles && !utility::re_managed_object::get_field<bool>(m_camera_system->mainCameraController, "SwitchingCamera")) {
-                m_ignore_next_player_angles = false;
-            }
+    const auto is_player_camera = m_camera_system->cameraController == m_player_camera_controller;
+    const auto restore_angles = is_player_camera && m_ignore_next_player_angles;
 
-            *(glm::quat*)&controller->worldRotation = m_last_controller_rotation;
-            controller->pitch = m_last_controller_angles.x;
-            controller->yaw = m_last_controller_angles.y;
-        }
-        else {
+    if (is_player_camera) {
+        // keep ignoring player input until no longer switching cameras
+        if (!restore_angles || !m_switching_camera_field.get(m_camera_system->mainCameraController)) {
             m_ignore_next_player_angles = false;
         }
-
-        m_last_controller_angles = Vector3f{ controller->pitch, controller->yaw, 0.0f };
     }
 
-    m_last_controller_pos = controller->worldPosition;
-    m_last_controller_rotation = *(glm::quat*) & controller->worldRotation;
+    // Read-modify-write in one go, update_camera_transform writes this from another thread
+    m_controller_state.update([&](const ControllerState& state) {
+        return first_person::record_controller(state, *controller, is_player_camera, restore_angles);
+    });
 }
 
 void FirstPerson::reset() {
-    m_rotation_offset = glm::identity<decltype(m_rotation_offset)>();
-    m_interpolated_bone = glm::identity<decltype(m_interpolated_bone)>();
-    m_last_camera_matrix = glm::identity<decltype(m_last_camera_matrix)>();
-    m_last_bone_matrix = glm::identity<decltype(m_last_bone_matrix)>();
-    m_last_controller_pos = Vector4f{};
-    m_last_controller_rotation = glm::quat{};
-    m_cached_bone_matrix = nullptr;
+    {
+        std::lock_guard _{ m_interp_mutex };
+        m_rotation_offset = glm::identity<decltype(m_rotation_offset)>();
+        m_interpolated_bone = glm::identity<decltype(m_interpolated_bone)>();
+    }
+
+    m_last_camera_matrix.store(glm::identity<Matrix4x4f>());
+    m_last_bone_matrix.store(glm::identity<Matrix4x4f>());
+    m_controller_state.store({});
 
     std::lock_guard _{ m_frame_mutex };
     m_attach_names.clear();
@@ -438,7 +438,7 @@ void FirstPerson::update_player_transform(RETransform* transform) {
     player_forward[1] = 0.0f;
     player_forward = glm::normalize(player_forward);
 
-    auto camera_matrix = m_last_camera_matrix;
+    auto camera_matrix = m_last_camera_matrix.load();
 
     auto cam_forward3 = *(Vector3f*)&camera_matrix[2];
 
@@ -470,9 +470,7 @@ void FirstPerson::update_player_transform(RETransform* transform) {
 }
 
 void FirstPerson::update_camera_transform(RETransform* transform) {
-    std::lock_guard _{ m_matrix_mutex };
-
-    m_last_camera_type = utility::re_managed_object::get_field<app::ropeway::camera::CameraControlType>(m_camera_system, "BusyCameraType");
+    m_last_camera_type = m_busy_camera_type_field.get(m_camera_system);
 
     // Don't mess with the camera if we're in a cutscene
     if (!is_first_person_allowed()) {
@@ -484,9 +482,13 @@ void FirstPerson::update_camera_transform(RETransform* transform) {
     auto& mtx = transform->worldTransform;
     auto& camera_pos = mtx[3];
 
-    auto cam_pos3 = Vector3f{ m_last_controller_pos };
+    // Snapshot of what the other callbacks published
+    const auto controller_state = m_controller_state.load();
+    const auto last_bone_matrix = m_last_bone_matrix.load();
+
+    auto cam_pos3 = Vector3f{ controller_state.position };
 
-    auto camera_matrix = m_last_camera_matrix * Matrix4x4f{
+    auto camera_matrix = m_last_camera_matrix.load() * Matrix4x4f{
         -1, 0, 0, 0,
         0, 1, 0, 0,
         0, 0, -1, 0,
@@ -494,11 +496,14 @@ void FirstPerson::update_camera_transform(RETransform* transform) {
     };
 
     const auto is_player_camera = m_last_camera_type == app::ropeway::camera::CameraControlType::PLAYER;
-    const auto is_switching_camera = utility::re_managed_object::get_field<bool>(m_camera_system->mainCameraController, "SwitchingCamera");
+    const auto is_switching_camera = m_switching_camera_field.get(m_camera_system->mainCameraController);
     const auto is_player_in_control = (is_player_camera && !is_switching_camera);
     const auto is_switching_to_player_camera = is_player_camera && is_switching_camera;
     //is_player_camera = is_player_camera && !is_switching_camera;
 
+    // Everything from here until final_mat is just math on our own state
+    std::unique_lock interp_lock{ m_interp_mutex };
+
     m_interp_bone_scale = glm::lerp(m_interp_bone_scale, m_bone_scale->value(), std::clamp(delta_time * 0.05f, 0.0f, 1.0f));
     m_interp_camera_speed = glm::lerp(m_interp_camera_speed, m_camera_scale->value(), std::clamp(delta_time * 0.05f, 0.0f, 1.0f));
 
@@ -538,11 +543,11 @@ void FirstPerson::update_camera_transform(RETransform* transform) {
         m_camera_system->mainCameraController->updateCamera = true;
     }
 
-    camera_matrix[3] = m_last_bone_matrix[3];
+    camera_matrix[3] = last_bone_matrix[3];
     auto& bone_pos = camera_matrix[3];
 
-    auto cam_rot_mat = glm::extractMatrixRotation(Matrix4x4f{ m_last_controller_rotation });
-    auto head_rot_mat = glm::extractMatrixRotation(m_last_bone_matrix) * Matrix4x4f {
+    auto cam_rot_mat = glm::extractMatrixRotation(Matrix4x4f{ controller_state.rotation });
+    auto head_rot_mat = glm::extractMatrixRotation(last_bone_matrix) * Matrix4x4f {
         -1, 0, 0, 0,
         0, 1, 0, 0,
         0, 0, -1, 0,
@@ -587,6 +592,8 @@ void FirstPerson::update_camera_transform(RETransform* transform) {
     auto final_mat = is_player_camera ? (m_interpolated_bone * m_rotation_offset) : m_interpolated_bone;
     auto final_quat = glm::quat{ final_mat };
 
+    interp_lock.unlock();
+
     // Apply the same matrix data to other things stored in-game (positions/quaternions)
     camera_pos = Vector4f{ final_pos, 1.0f };
     m_camera_system->cameraController->worldPosition = *(Vector4f*)&camera_pos;
@@ -598,40 +605,45 @@ void FirstPerson::update_camera_transform(RETransform* transform) {
     *(Matrix3x4f*)&mtx = final_mat;
 
     //if (is_player_in_control || !is_player_camera) {
-        m_last_camera_matrix = mtx;
+        m_last_camera_matrix.store(mtx);
     //}
 
     // Fixes snappiness after camera switching
     if (!is_player_in_control) {
-        m_last_controller_pos = m_camera_system->cameraController->worldPosition;
-        m_last_controller_rotation = final_quat;
+        ControllerState state{};
 
-        m_camera_system->mainCameraController->cameraPosition = m_last_controller_pos;
+        state.position = m_camera_system->cameraController->worldPosition;
+        state.rotation = final_quat;
+
+        m_camera_system->mainCameraController->cameraPosition = state.position;
         m_camera_system->mainCameraController->cameraRotation = *(Vector4f*)&final_quat;
 
         //if (!is_switching_to_player_camera) {
-            m_last_controller_angles = utility::math::euler_angles(final_mat);
+            state.angles = utility::math::euler_angles(final_mat);
         //}
 
+        // Every field is replaced, writers are serialized so this can't split on_update_camera_controller2's update
+        m_controller_state.store(state);
+
         // These are what control the real rotation, so only set it in a cutscene or something
         // If we did it all the time, the view would drift constantly
-        //m_camera_system->cameraController->pitch = m_last_controller_angles.x;
-        //m_camera_system->cameraController->yaw = m_last_controller_angles.y;
+        //m_camera_system->cameraController->pitch = state.angles.x;
+        //m_camera_system->cameraController->yaw = state.angles.y;
 
         if (m_player_camera_controller != nullptr) {
             m_player_camera_controller->worldPosition = m_camera_system->cameraController->worldPosition;
             m_player_camera_controller->worldRotation = m_camera_system->cameraController->worldRotation;
 
             /*if (m_last_camera_type == app::ropeway::camera::CameraControlType::PLAYER) {
-                m_last_controller_angles.z = 0.0f;
+                state.angles.z = 0.0f;
 
-                m_last_controller_angles += (prev_angles - m_last_controller_angles) * delta_time;
+                state.angles += (prev_angles - state.angles) * delta_time;
             }*/
 
             // Forces the game to keep the previous angles/rotation we set after exiting a cutscene
             //if (!is_switching_to_player_camera) {
-                m_player_camera_controller->pitch = m_last_controller_angles.x;
-                m_player_camera_controller->yaw = m_last_controller_angles.y;
+                m_player_camera_controller->pitch = state.angles.x;
+                m_player_camera_controller->yaw = state.angles.y;
             //}
 
             m_ignore_next_player_angles = !is_switching_to_player_camera;
@@ -639,7 +651,7 @@ void FirstPerson::update_camera_transform(RETransform* transform) {
     }
 
     if (transform->joints.size >= 1 && transform->joints.matrices != nullptr) {
-        transform->joints.matrices->data[0].worldMatrix = m_last_camera_matrix;
+        transform->joints.matrices->data[0].worldMatrix = mtx;
     }
 }
 
@@ -659,20 +671,20 @@ void FirstPerson::update_player_bones(RETransform* transform) {
     if (g_first_time) {
         auto& bone_matrix = utility::re_transform::get_joint_matrix(*m_player_transform, m_attach_bone);
 
-        m_cached_bone_matrix = &bone_matrix;
-        m_last_bone_matrix = bone_matrix;
+        g_cached_bone_matrix = &bone_matrix;
+        m_last_bone_matrix.store(bone_matrix);
         g_first_time = false;
     }
 
-    if (m_cached_bone_matrix == nullptr) {
+    if (g_cached_bone_matrix == nullptr) {
         return;
     }
 
-    auto& bone_matrix = *m_cached_bone_matrix;
+    auto& bone_matrix = *g_cached_bone_matrix;
 
     // Forcefully rotate the bone to match the camera direction
     if (m_camera_system->cameraController == m_player_camera_controller && m_rotate_mesh->value()) {
-        auto wanted_mat = m_last_camera_matrix * Matrix4x4f{
+        auto wanted_mat = m_last_camera_matrix.load() * Matrix4x4f{
             -1, 0, 0, 0,
             0, 1, 0, 0,
             0, 0, -1, 0,
@@ -684,9 +696,7 @@ void FirstPerson::update_player_bones(RETransform* transform) {
 
     // Hide the head model by moving it out of view of the camera (and hopefully shadows...)
     if (m_hide_mesh->value()) {
-        bone_matrix[0] = Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f };
-        bone_matrix[1] = Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f };
-        bone_matrix[2] = Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f };
+        utility::re_pose::scale(&bone_matrix, 1, 0.0f);
     }
 }
 
@@ -748,17 +758,12 @@ void FirstPerson::update_joint_names() {
         return;
     }
 
-    auto& joints = m_player_transform->joints;
-
-    for (int32_t i = 0; joints.data != nullptr && i < joints.size; ++i) {
-        auto joint = joints.data->joints[i];
-
+    for (auto joint : utility::re_transform::get_joints(*m_player_transform)) {
         if (joint == nullptr || joint->info == nullptr || joint->info->name == nullptr) {
             continue;
         }
 
-        auto name = std::wstring{ joint->info->name };
-        m_attach_names.push_back(utility::narrow(name).c_str());
+        m_attach_names.emplace_back(utility::narrow_interned(joint->info->name));
     }
 }
 
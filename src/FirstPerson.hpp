@@ -1,10 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <mutex>
 
 #include "Mod.hpp"
 #include "utility/Patch.hpp"
+#include "utility/SeqLock.hpp"
 
 class FirstPerson : public Mod {
 public:
@@ -44,8 +46,8 @@ private:
     float update_delta_time(REComponent* component);
     bool is_first_person_allowed() const;
 
-    // Needs to be recursive for some reason. Otherwise freeze.
-    std::recursive_mutex m_matrix_mutex{};
+    // Only held around the camera interpolation math, never across engine code.
+    std::mutex m_interp_mutex{};
     std::mutex m_frame_mutex{};
     std::mutex m_delta_mutex{};
 
@@ -55,16 +57,24 @@ private:
 
     // Different "configs" for each model
     std::unordered_map<std::string, Vector4f> m_attach_offsets;
+
+    // Interpolation state, guarded by m_interp_mutex
     Matrix4x4f m_rotation_offset{ glm::identity<Matrix4x4f>() };
     Matrix4x4f m_interpolated_bone{ glm::identity<Matrix4x4f>() };
-    Matrix4x4f m_last_bone_matrix{ glm::identity<Matrix4x4f>() };
-    Matrix4x4f m_last_camera_matrix{ glm::identity<Matrix4x4f>() };
-    Matrix4x4f* m_cached_bone_matrix{ nullptr };
-    Vector4f m_last_controller_pos{};
-    glm::quat m_last_controller_rotation{};
-    Vector3f m_last_controller_angles{};
-    bool m_ignore_next_player_angles{ false };
-    app::ropeway::camera::CameraControlType m_last_camera_type{};
+
+    struct ControllerState {
+        Vector4f position{};
+        glm::quat rotation{};
+        Vector3f angles{};
+    };
+
+    // Shared between the transform and camera controller callbacks, which run on different threads.
+    // Published through seqlocks so nobody waits on a thread that's busy inside UpdateTransform.
+    utility::SeqLock<Matrix4x4f> m_last_bone_matrix{ glm::identity<Matrix4x4f>() };
+    utility::SeqLock<Matrix4x4f> m_last_camera_matrix{ glm::identity<Matrix4x4f>() };
+    utility::SeqLock<ControllerState> m_controller_state{};
+    std::atomic<bool> m_ignore_next_player_angles{ false };
+    std::atomic<app::ropeway::camera::CameraControlType> m_last_camera_type{};
 
     // Don't show first person when the camera is not one of these
     std::unordered_set<app::ropeway::camera::CameraControlType> m_allowed_camera_types{
@@ -87,6 +97,10 @@ private:
     RopewayPostEffectController* m_post_effect_controller{ nullptr };
     RopewayPostEffectControllerBase* m_tone_mapping_controller{ nullptr };
 
+    // Read every player/camera transform update
+    utility::re_managed_object::FieldRef<app::ropeway::camera::CameraControlType> m_busy_camera_type_field{ "BusyCameraType" };
+    utility::re_managed_object::FieldRef<bool> m_switching_camera_field{ "SwitchingCamera" };
+
     std::vector<std::string> m_attach_names;
     int32_t m_attach_selected{ 0 };
     
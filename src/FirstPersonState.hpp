@@ -0,0 +1,31 @@
+#pragma once
+
+// What FirstPerson's camera callbacks do to the state they share, pulled out of the mod so it
+// can be hammered from threads without the game. Written against anything shaped like
+// ControllerState and RopewayPlayerCameraController (position/rotation/angles, and
+// worldPosition/worldRotation/pitch/yaw), the rotation is reinterpreted the same way the mod does.
+namespace first_person {
+    // on_update_camera_controller2, run inside m_controller_state.update().
+    // Restoring puts the saved angles back on the controller before it's recorded again,
+    // so the whole thing has to see one state and publish one state.
+    template <typename State, typename Controller>
+    State record_controller(State state, Controller& controller, bool is_player_camera, bool restore_angles) {
+        using Rotation = decltype(state.rotation);
+        using Angles = decltype(state.angles);
+
+        if (is_player_camera) {
+            if (restore_angles) {
+                *(Rotation*)&controller.worldRotation = state.rotation;
+                controller.pitch = state.angles.x;
+                controller.yaw = state.angles.y;
+            }
+
+            state.angles = Angles{ controller.pitch, controller.yaw, 0.0f };
+        }
+
+        state.position = controller.worldPosition;
+        state.rotation = *(Rotation*)&controller.worldRotation;
+
+        return state;
+    }
+}
@@ -88,7 +88,7 @@ void FreeCam::on_update_transform(RETransform* transform) {
     }
 
     // despite the name, it works with the keyboard
-    auto left_analog = utility::re_managed_object::get_field<RopewayInputSystemAnalogStick*>(m_input_system, "_LStick");
+    auto left_analog = m_left_stick_field.get(m_input_system);
 
     if (left_analog == nullptr) {
         return;
@@ -98,7 +98,7 @@ void FreeCam::on_update_transform(RETransform* transform) {
     if (!m_lock_camera->value()) {
         // Move direction
         // It's not a Vector2f because via.vec2 is not actually 8 bytes, we don't want stack corruption to occur.
-        auto axis = utility::re_managed_object::get_field<Vector3f>(left_analog, "Axis");
+        auto axis = m_axis_field.get(left_analog);
         auto dir = Vector4f{ axis.x, 0.0f, axis.y * -1.0f, 0.0f };
 
         auto delta = utility::re_component::get_delta_time(transform);
@@ -43,6 +43,9 @@ private:
     RopewayInputSystem* m_input_system{ nullptr };
     RopewaySurvivorManager* m_survivor_manager{ nullptr };
 
+    utility::re_managed_object::FieldRef<RopewayInputSystemAnalogStick*> m_left_stick_field{ "_LStick" };
+    utility::re_managed_object::FieldRef<Vector3f> m_axis_field{ "Axis" };
+
     Matrix4x4f m_last_camera_matrix{ glm::identity<Matrix4x4f>() };
 
     bool m_first_time{ true };
@@ -2,6 +2,7 @@
 
 #include "IntegrityCheckBypass.hpp"
 #include "PositionHooks.hpp"
+#include "SceneIndex.hpp"
 #include "FirstPerson.hpp"
 #include "DeveloperTools.hpp"
 #include "ManualFlashlight.hpp"
@@ -16,6 +17,7 @@ Mods::Mods()
 #endif
 
     m_mods.emplace_back(std::make_unique<PositionHooks>());
+    m_mods.emplace_back(std::make_unique<SceneIndex>());
     m_mods.emplace_back(std::make_unique<FirstPerson>());
     m_mods.emplace_back(std::make_unique<ManualFlashlight>());
     m_mods.emplace_back(std::make_unique<FreeCam>());
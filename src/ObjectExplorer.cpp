@@ -6,6 +6,7 @@
 
 #include "utility/String.hpp"
 #include "utility/Scan.hpp"
+#include "sdk/RETypeDB.hpp"
 
 #include "REFramework.hpp"
 #include "ObjectExplorer.hpp"
@@ -14,6 +15,8 @@ ObjectExplorer::ObjectExplorer()
 {
     m_type_name.reserve(256);
     m_object_address.reserve(256);
+    m_member_name.reserve(256);
+    m_snapshot_type_name.reserve(256);
 }
 
 void ObjectExplorer::on_draw_ui() {
@@ -25,11 +28,28 @@ void ObjectExplorer::on_draw_ui() {
 
     if (m_do_init) {
         populate_classes();
-        populate_enums();
     }
 
     auto curtime = std::chrono::system_clock::now();
 
+    // Getter only, compare discovered offsets against the getters, or switch to direct loads once they match
+    static const char* access_modes[] = { "Getter", "Verify", "Direct" };
+    auto access_mode = (int32_t)utility::re_managed_object::get_field_access_mode();
+
+    if (ImGui::Combo("Field Access", &access_mode, access_modes, IM_ARRAYSIZE(access_modes))) {
+        utility::re_managed_object::set_field_access_mode((utility::re_managed_object::FieldAccessMode)access_mode);
+    }
+
+    // Written on a worker thread, the catalog is built in the background at startup
+    if (ImGui::Button("Export Enums_Internal.hpp") && !sdk::export_enum_catalog("Enums_Internal.hpp")) {
+        spdlog::info("Enum catalog isn't ready yet");
+    }
+
+    // Types, members, offsets and enums in one mappable file for tools/typedb
+    if (ImGui::Button("Export Type Database") && !sdk::export_type_db("re_typedb.bin")) {
+        spdlog::info("Member index or enum catalog isn't ready yet");
+    }
+
     // List of globals to choose from
     if (ImGui::CollapsingHeader("Singletons")) {
         if (curtime > m_next_refresh) {
@@ -37,82 +57,55 @@ void ObjectExplorer::on_draw_ui() {
             m_next_refresh = curtime + std::chrono::seconds(1);
         }
 
-        // make a copy, we want to sort by name
-        auto singletons = g_framework->get_globals()->get_objects();
-
-        // first loop, sort
-        std::sort(singletons.begin(), singletons.end(), [](REManagedObject** a, REManagedObject** b) {
-            auto a_type = utility::re_managed_object::safe_get_type(*a);
-            auto b_type = utility::re_managed_object::safe_get_type(*b);
-
-            if (a_type == nullptr || a_type->name == nullptr) {
-                return true;
-            }
-
-            if (b_type == nullptr || b_type->name == nullptr) {
-                return false;
-            }
-
-            return std::string_view{ a_type->name } < std::string_view{ b_type->name };
-        });
+        // Already validated and sorted by name, only redone when a global changes
+        auto singletons = g_framework->get_globals()->get_sorted_objects();
 
         // Display the nodes
-        for (auto obj : singletons) {
-            auto t = utility::re_managed_object::safe_get_type(*obj);
-
-            if (t == nullptr || t->name == nullptr) {
-                continue;
-            }
-
+        for (auto& singleton : *singletons) {
             ImGui::SetNextTreeNodeOpen(false, ImGuiCond_::ImGuiCond_Once);
 
-            auto made_node = ImGui::TreeNode(t->name);
-            context_menu(*obj);
+            auto made_node = ImGui::TreeNode(singleton.type->name);
+            context_menu(singleton.obj);
 
             if (made_node) {
-                handle_address(*obj);
+                handle_address(singleton.obj);
                 ImGui::TreePop();
             }
         }
     }
 
     if (ImGui::CollapsingHeader("Types")) {
-        std::vector<uint8_t> fake_type{ 0 };
+        draw_type_tree();
+    }
 
-        for (const auto& name : m_sorted_types) {
-            fake_type.clear();
+    if (ImGui::CollapsingHeader("Member Search")) {
+        draw_member_search();
+    }
 
-            auto t = get_type(name);
+    if (ImGui::CollapsingHeader("Object Graph")) {
+        draw_object_graph();
+    }
 
-            if (t == nullptr) {
-                continue;
-            }
+    if (ImGui::CollapsingHeader("Snapshot Diff")) {
+        draw_snapshot_diff();
+    }
 
-            if (t->size >= fake_type.capacity()) {
-                fake_type.reserve(t->size);
-            }
+    // Search again with the index once it's there
+    auto index_ready = false;
 
-            handle_type((REManagedObject*)fake_type.data(), t);
-        }
+    if (m_type_index_future.valid() && m_type_index_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        m_type_index = std::make_shared<const utility::TrigramIndex>(m_type_index_future.get());
+        index_ready = true;
     }
 
-    if (m_do_init || ImGui::InputText("Type Name", m_type_name.data(), 256)) {
-        m_displayed_types.clear();
+    if (ImGui::InputText("Type Name", m_type_name.data(), 256) || m_do_init || index_ready) {
+        search_types();
+    }
 
-        if (auto t = get_type(m_type_name.data())) {
-            m_displayed_types.push_back(t);
-        }
-        else {
-            // Search the list for a partial match instead
-            for (auto i = std::find_if(m_sorted_types.begin(), m_sorted_types.end(), [this](const auto& a) { return a.find(m_type_name.data()) != std::string::npos; });
-                i != m_sorted_types.end();
-                i = std::find_if(i + 1, m_sorted_types.end(), [this](const auto& a) { return a.find(m_type_name.data()) != std::string::npos; }))
-            {
-                if (auto t = get_type(*i)) {
-                    m_displayed_types.push_back(t);
-                }
-            }
-        }
+    show_type_search_results();
+
+    if (m_shown_type_search_results != nullptr && m_shown_type_search_results->fuzzy) {
+        ImGui::Text("No exact matches, showing similar names");
     }
 
     ImGui::InputText("REObject Address", m_object_address.data(), 16, ImGuiInputTextFlags_::ImGuiInputTextFlags_CharsHexadecimal);
@@ -145,7 +138,7 @@ void ObjectExplorer::handle_address(Address address, int32_t offset, Address par
     }
 
     bool made_node = false;
-    auto is_game_object = utility::re_managed_object::is_a(object, "via.GameObject");
+    auto is_game_object = utility::re_managed_object::is_a(object, m_game_object_type);
 
     if (offset != -1) {
         ImGui::SetNextTreeNodeOpen(false, ImGuiCond_::ImGuiCond_Once);
@@ -157,7 +150,7 @@ void ObjectExplorer::handle_address(Address address, int32_t offset, Address par
         context_menu(object);
 
         if (is_game_object) {
-            additional_text = utility::re_string::get_string(address.as<REGameObject*>()->name);
+            additional_text = utility::re_string::get_interned(address.as<REGameObject*>()->name);
         }
         else {
             // Change name based on VMType
@@ -206,7 +199,7 @@ void ObjectExplorer::handle_address(Address address, int32_t offset, Address par
             handle_game_object(address.as<REGameObject*>());
         }
 
-        if (utility::re_managed_object::is_a(object, "via.Component")) {
+        if (utility::re_managed_object::is_a(object, m_component_type)) {
             handle_component(address.as<REComponent*>());
         }
 
@@ -232,7 +225,7 @@ void ObjectExplorer::handle_address(Address address, int32_t offset, Address par
 }
 
 void ObjectExplorer::handle_game_object(REGameObject* game_object) {
-    ImGui::Text("Name: %s", utility::re_string::get_string(game_object->name).c_str());
+    ImGui::Text("Name: %s", utility::re_string::get_interned(game_object->name).data());
     make_tree_offset(game_object, offsetof(REGameObject, transform), "Transform");
     make_tree_offset(game_object, offsetof(REGameObject, folder), "Folder");
 }
@@ -344,13 +337,13 @@ void ObjectExplorer::display_enum_value(std::string_view name, int64_t value) {
     if (!first_found.empty()) {
         ImGui::Text("%i: ", value);
         ImGui::SameLine();
-        ImGui::TextColored(VARIABLE_COLOR, "%s", first_found.c_str());
+        ImGui::TextColored(VARIABLE_COLOR, "%.*s", (int)first_found.size(), first_found.data());
     }
     // Assume it's a set of flags then
     else {
         ImGui::Text("%i", value);
 
-        std::vector<std::string> names{};
+        std::vector<std::string_view> names{};
 
         // Check which bits are set and have enum names
         for (auto i = 0; i < 32; ++i) {
@@ -368,7 +361,7 @@ void ObjectExplorer::display_enum_value(std::string_view name, int64_t value) {
         // Sort and print names
         std::sort(names.begin(), names.end());
         for (const auto& value_name : names) {
-            ImGui::TextColored(VARIABLE_COLOR, "%s", value_name.c_str());
+            ImGui::TextColored(VARIABLE_COLOR, "%.*s", (int)value_name.size(), value_name.data());
         }
     }
 }
@@ -443,6 +436,11 @@ void ObjectExplorer::display_fields(REManagedObject* obj, REType* type_info) {
     auto descriptors = type_info->fields->variables->data->descriptors;
 
     if (ImGui::TreeNode(type_info->fields, "Fields: %i", type_info->fields->variables->num)) {
+        // Work out every offset of the object in one go instead of field by field
+        if (is_real_object) {
+            discover_field_offsets(obj, utility::re_managed_object::get_type(obj));
+        }
+
         for (auto i = descriptors; i != descriptors + type_info->fields->variables->num; ++i) {
             auto variable = *i;
 
@@ -499,7 +497,9 @@ void ObjectExplorer::display_fields(REManagedObject* obj, REType* type_info) {
 
                     auto type_kind = variable->flags & 0x1F;
 
-                    ImGui::Text("TypeKind: %i (%s)", type_kind, get_enum_value_name("via.reflection.TypeKind", (int64_t)type_kind).c_str());
+                    auto type_kind_name = get_enum_value_name("via.reflection.TypeKind", (int64_t)type_kind);
+
+                    ImGui::Text("TypeKind: %i (%.*s)", type_kind, (int)type_kind_name.size(), type_kind_name.data());
                     ImGui::Text("VarType: %i", variable->variableType);
 
                     if (variable->staticVariableData != nullptr) {
@@ -714,23 +714,88 @@ void ObjectExplorer::attempt_display_field(REManagedObject* obj, VariableDescrip
     }
 }
 
+// Reference count of the thread context before we started calling getters,
+// so the translator knows what to clean up after an access violation.
+static int32_t g_prev_reference_count = 0;
+
 int32_t ObjectExplorer::get_field_offset(REManagedObject* obj, VariableDescriptor* desc) {
     if (desc->typeName == nullptr || desc->function == nullptr || m_offset_map.find(desc) != m_offset_map.end()) {
         return m_offset_map[desc];
     }
 
-    auto ret = utility::hash(std::string{ desc->typeName });
+    if (auto known_offset = utility::re_managed_object::get_field_offset(desc)) {
+        return m_offset_map[desc] = *known_offset;
+    }
 
     // These usually modify the object state, not what we want.
-    if (ret == "undefined"_fnv) {
+    if (utility::hash(std::string{ desc->typeName }) == "undefined"_fnv) {
         return m_offset_map[desc];
     }
 
-    static int32_t prev_reference_count = 0;
+    prepare_field_getters();
+
+    // Works on copies of the object so we don't cause a crash by replacing
+    // data that's being used by the game
+    auto finder = make_offset_finder(obj);
+    auto offset = find_field_offset(finder, obj, desc);
+
+    if (offset == 0 && !is_reference_field(desc)) {
+        offset = finder.find_bytewise([&](uint8_t* o, uint8_t* out) { return call_field_getter(desc, o, out); });
+    }
+
+    set_discovered_offset(desc, offset);
+
+    return offset;
+}
+
+void ObjectExplorer::discover_field_offsets(REManagedObject* obj, REType* t) {
+    if (m_discovered_types.count(t) > 0) {
+        return;
+    }
+
+    m_discovered_types.insert(t);
+
+    prepare_field_getters();
+
+    // One patterned copy shared by every field of the type and its parents.
+    auto finder = make_offset_finder(obj);
+
+    for (auto type_info = t; type_info != nullptr; type_info = type_info->super) {
+        auto vars = utility::re_managed_object::get_variables(type_info);
+
+        if (vars == nullptr) {
+            continue;
+        }
+
+        for (auto i = 0; i < vars->num; ++i) {
+            auto desc = vars->data->descriptors[i];
+
+            if (desc == nullptr || desc->typeName == nullptr || desc->function == nullptr || m_offset_map.find(desc) != m_offset_map.end()) {
+                continue;
+            }
+
+            if (auto known_offset = utility::re_managed_object::get_field_offset(desc)) {
+                m_offset_map[desc] = *known_offset;
+                continue;
+            }
+
+            if (utility::hash(std::string{ desc->typeName }) == "undefined"_fnv) {
+                continue;
+            }
+
+            // Whatever isn't found here goes through get_field_offset (and the bytewise fallback) when it's displayed.
+            if (auto offset = find_field_offset(finder, obj, desc); offset != 0) {
+                set_discovered_offset(desc, offset);
+            }
+        }
+    }
+}
+
+void ObjectExplorer::prepare_field_getters() {
     auto thread_context = sdk::get_thread_context();
 
     if (thread_context != nullptr) {
-        prev_reference_count = thread_context->referenceCount;
+        g_prev_reference_count = thread_context->referenceCount;
     }
 
     // Set up our "translator" to throw on any exception,
@@ -750,7 +815,7 @@ int32_t ObjectExplorer::get_field_offset(REManagedObject* obj, VariableDescripto
             // We also need to "destruct" whatever object this is.
             if (thread_context != nullptr) {
                 auto& reference_count = thread_context->referenceCount;
-                auto count_delta = reference_count - prev_reference_count;
+                auto count_delta = reference_count - g_prev_reference_count;
 
                 spdlog::error("{}", reference_count);
                 if (count_delta >= 1) {
@@ -806,75 +871,53 @@ int32_t ObjectExplorer::get_field_offset(REManagedObject* obj, VariableDescripto
 
         throw std::exception(std::to_string(code).c_str());
     });
+}
 
-    struct BitTester {
-        BitTester(uint8_t* old_value)
-            : ptr{ old_value }
-        {
-            old = *old_value;
-        }
+bool ObjectExplorer::call_field_getter(VariableDescriptor* desc, uint8_t* obj, uint8_t* out) {
+    const auto get_value_func = (void* (*)(VariableDescriptor*, REManagedObject*, void*))desc->function;
 
-        ~BitTester() {
-            *ptr = old;
-        }
+    // Attempt to get the field value.
+    try {
+        get_value_func(desc, (REManagedObject*)obj, out);
+    }
+    // Access violation occurred. Good thing we handle it.
+    catch (const std::exception&) {
+        return false;
+    }
 
-        bool is_value_same(const uint8_t* buf) const {
-            return buf[0] == ptr[0];
-        }
+    return true;
+}
 
-        uint8_t* ptr;
-        uint8_t old;
-    };
+bool ObjectExplorer::is_reference_field(VariableDescriptor* desc) {
+    const auto kind = (via::reflection::TypeKind)(desc->flags & 0x1F);
+    return kind == via::reflection::TypeKind::Class || kind == via::reflection::TypeKind::String;
+}
 
-    const auto get_value_func = (void* (*)(VariableDescriptor*, REManagedObject*, void*))desc->function;
+utility::OffsetFinder ObjectExplorer::make_offset_finder(REManagedObject* obj) {
     const auto class_size = utility::re_managed_object::get_size(obj);
-    const auto size = 1;
-
-    // Copy the object so we don't cause a crash by replacing
-    // data that's being used by the game
-    std::vector<uint8_t> object_copy;
-    object_copy.reserve(class_size);
-    memcpy(object_copy.data(), obj, class_size);
-
-    // Compare data
-    for (int32_t i = sizeof(REManagedObject); i + size <= (int32_t)class_size; i += 1) {
-        auto ptr = object_copy.data() + i;
-        bool same = true;
-
-        BitTester tester{ ptr };
 
-        // Compare data twice, first run no modifications,
-        // second run, slightly modify the data to double check if it's what we want.
-        for (int32_t k = 0; k < 2; ++k) {
-            std::array<uint8_t, 0x100> data{ 0 };
+    // Anything in the object that looks like a readable pointer keeps its value, some getters follow them.
+    return utility::OffsetFinder{ (const uint8_t*)obj, class_size, sizeof(REManagedObject), [](uintptr_t value) {
+        return value >= 0x10000 && !IsBadReadPtr((const void*)value, sizeof(void*));
+    } };
+}
 
-            // Attempt to get the field value.
-            try {
-                get_value_func(desc, (REManagedObject*)object_copy.data(), data.data());
-            }
-            // Access violation occurred. Good thing we handle it.
-            catch (const std::exception&) {
-                same = false;
-                break;
-            }
+int32_t ObjectExplorer::find_field_offset(utility::OffsetFinder& finder, REManagedObject* obj, VariableDescriptor* desc) {
+    auto getter = [&](uint8_t* o, uint8_t* out) { return call_field_getter(desc, o, out); };
 
-            // Check if result is the same at our offset.
-            if (!tester.is_value_same(data.data())) {
-                same = false;
-                break;
-            }
+    // References can't be patterned, swap the real object in for them instead
+    if (is_reference_field(desc)) {
+        return finder.find_pointer(getter, (uintptr_t)obj);
+    }
 
-            // Modify the data for our second run.
-            *ptr ^= 1;
-        }
+    return finder.find(getter);
+}
 
-        if (same) {
-            m_offset_map[desc] = i;
-            break;
-        }
-    }
+void ObjectExplorer::set_discovered_offset(VariableDescriptor* desc, int32_t offset) {
+    m_offset_map[desc] = offset;
 
-    return m_offset_map[desc];
+    // Let get_field switch to direct loads for this field once it's verified
+    utility::re_managed_object::set_field_offset(desc, offset);
 }
 
 bool ObjectExplorer::widget_with_context(void* address, std::function<bool()> widget) {
@@ -893,8 +936,14 @@ void ObjectExplorer::context_menu(void* address) {
             ImGui::SetClipboardText(ss.str().c_str());
         }
 
+        if (is_managed_object(address) && ImGui::Selectable("Watch For Changes")) {
+            if (std::find(m_watched_objects.begin(), m_watched_objects.end(), address) == m_watched_objects.end()) {
+                m_watched_objects.push_back((REManagedObject*)address);
+            }
+        }
+
         // Log component hierarchy to disk
-        if (is_managed_object(address) && utility::re_managed_object::is_a((REManagedObject*)address, "via.Component") && ImGui::Selectable("Log Hierarchy")) {
+        if (is_managed_object(address) && utility::re_managed_object::is_a((REManagedObject*)address, m_component_type) && ImGui::Selectable("Log Hierarchy")) {
             auto comp = (REComponent*)address;
 
             for (auto obj = comp; obj; obj = obj->childComponent) {
@@ -951,86 +1000,479 @@ bool ObjectExplorer::is_managed_object(Address address) const {
 }
 
 void ObjectExplorer::populate_classes() {
-    auto& type_list = *g_framework->get_types()->get_raw_types();
-    spdlog::info("TypeList: {:x}", (uintptr_t)&type_list);
+    auto& types = g_framework->get_types();
+    spdlog::info("TypeList: {:x}", (uintptr_t)types->get_raw_types());
 
-    // I don't know why but it can extend past the size.
-    for (auto i = 0; i < type_list.numAllocated; ++i) {
-        auto t = (*type_list.data)[i];
+    // RETypes already walked the list, just borrow its names
+    types->safe_refresh();
+    m_sorted_types = types->get_names();
 
-        if (t == nullptr || IsBadReadPtr(t, sizeof(REType))) {
-            continue;
+    std::sort(m_sorted_types.begin(), m_sorted_types.end());
+
+    m_type_tree_future = std::async(std::launch::async, &ObjectExplorer::build_type_tree, m_sorted_types);
+    m_type_index_future = std::async(std::launch::async, [names = m_sorted_types]() { return utility::TrigramIndex{ names }; });
+}
+
+void ObjectExplorer::search_types() {
+    const std::string_view query{ m_type_name.data() };
+
+    if (auto t = get_type(query)) {
+        m_displayed_types.clear();
+        m_displayed_types.push_back(t);
+        m_shown_type_search_results.reset();
+        m_waiting_for_type_search = false;
+        return;
+    }
+
+    // Index isn't built yet, search the list for a partial match instead
+    if (m_type_index == nullptr) {
+        m_displayed_types.clear();
+        m_shown_type_search_results.reset();
+
+        for (auto i = std::find_if(m_sorted_types.begin(), m_sorted_types.end(), [&](const auto& a) { return a.find(query) != std::string::npos; });
+            i != m_sorted_types.end();
+            i = std::find_if(i + 1, m_sorted_types.end(), [&](const auto& a) { return a.find(query) != std::string::npos; }))
+        {
+            if (auto t = get_type(*i)) {
+                m_displayed_types.push_back(t);
+            }
         }
 
-        if (t->name == nullptr) {
-            continue;
+        return;
+    }
+
+    // Whatever's shown stays up until the worker has an answer for this one.
+    // Cancel first, so the run that picks this query up can't see a cancel meant for the one before.
+    m_type_search_cancel = true;
+    m_type_search_worker.post({ m_type_index, std::string{ query } });
+    m_waiting_for_type_search = true;
+}
+
+void ObjectExplorer::run_type_search(TypeSearchQuery query) {
+    m_type_search_cancel = false;
+
+    // The last results are ids into the old index
+    if (query.index != m_type_search_index) {
+        m_type_search = utility::TrigramIndex::Search{ 256 };
+        m_type_search_index = query.index;
+    }
+
+    // Best matches first, typing more only narrows down the last results.
+    // Cancelled means a newer query is already waiting, that one gets published instead.
+    if (!m_type_search.update(*query.index, query.text, &m_type_search_cancel)) {
+        return;
+    }
+
+    auto results = std::make_shared<TypeSearchResults>();
+    results->query = std::move(query.text);
+    results->fuzzy = m_type_search.is_fuzzy();
+
+    for (auto& match : m_type_search.get_results()) {
+        results->names.push_back(query.index->get_names()[match.id]);
+    }
+
+    std::atomic_store(&m_type_search_results, std::shared_ptr<const TypeSearchResults>{ std::move(results) });
+}
+
+void ObjectExplorer::show_type_search_results() {
+    if (!m_waiting_for_type_search) {
+        return;
+    }
+
+    auto results = std::atomic_load(&m_type_search_results);
+
+    // Answers to anything but what's in the box now are stale
+    if (results == nullptr || results->query != m_type_name.data()) {
+        return;
+    }
+
+    m_waiting_for_type_search = false;
+    m_shown_type_search_results = results;
+    m_displayed_types.clear();
+
+    for (auto name : results->names) {
+        if (auto t = get_type(name)) {
+            m_displayed_types.push_back(t);
         }
+    }
+}
 
-        auto name = std::string{ t->name };
+std::vector<ObjectExplorer::TypeTreeNode> ObjectExplorer::build_type_tree(std::vector<std::string_view> names) {
+    // Sort with '.' below every other character, so "a.b", "a.b.C" and "a.b+X" come out in that order.
+    // Otherwise "a.b+X" would land between "a.b" and "a.b.C" and split the a.b namespace in two.
+    std::sort(names.begin(), names.end(), [](std::string_view a, std::string_view b) {
+        const auto n = std::min(a.size(), b.size());
 
-        if (name.empty()) {
-            continue;
+        for (size_t i = 0; i < n; ++i) {
+            if (a[i] != b[i]) {
+                return a[i] == '.' || (b[i] != '.' && (uint8_t)a[i] < (uint8_t)b[i]);
+            }
         }
 
-        spdlog::info("{:s}", name);
-        m_sorted_types.push_back(name);
-        m_types[name] = t;
+        return a.size() < b.size();
+    });
+
+    std::vector<TypeTreeNode> nodes{};
+    nodes.reserve(names.size() * 2);
+
+    // Path from the root to the last node we added
+    std::vector<uint32_t> stack{};
+    std::vector<std::string_view> parts{};
+
+    auto pop = [&]() {
+        nodes[stack.back()].end = (uint32_t)nodes.size();
+        stack.pop_back();
+    };
+
+    for (auto name : names) {
+        // Split on the dots outside of generic arguments, "System.Collections.Generic.List`1<app.Foo>"
+        parts.clear();
+
+        size_t start = 0;
+        int32_t nesting = 0;
+
+        for (size_t i = 0; i < name.size(); ++i) {
+            if (name[i] == '<' || name[i] == '[') {
+                ++nesting;
+            }
+            else if (name[i] == '>' || name[i] == ']') {
+                --nesting;
+            }
+            else if (name[i] == '.' && nesting == 0) {
+                parts.push_back(name.substr(start, i - start));
+                start = i + 1;
+            }
+        }
+
+        parts.push_back(name.substr(start));
+
+        // Sorted, so everything under a namespace is contiguous and we only ever have to look at the current path
+        size_t common = 0;
+
+        while (common < stack.size() && common < parts.size() && nodes[stack[common]].name == parts[common]) {
+            ++common;
+        }
+
+        while (stack.size() > common) {
+            pop();
+        }
+
+        for (auto i = common; i < parts.size(); ++i) {
+            stack.push_back((uint32_t)nodes.size());
+            nodes.push_back(TypeTreeNode{ parts[i], nullptr, 0, (uint32_t)i, false });
+        }
+
+        nodes[stack.back()].type = g_framework->get_types()->find(name);
     }
 
-    std::sort(m_sorted_types.begin(), m_sorted_types.end());
+    while (!stack.empty()) {
+        pop();
+    }
+
+    return nodes;
 }
 
-void ObjectExplorer::populate_enums() {
-    std::ofstream out_file("Enums_Internal.hpp");
+void ObjectExplorer::draw_type_tree() {
+    if (m_type_tree_future.valid()) {
+        if (m_type_tree_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ImGui::Text("Building type tree...");
+            return;
+        }
 
+        m_type_tree = m_type_tree_future.get();
+        m_type_tree_dirty = true;
+    }
+
+    if (m_type_tree_dirty) {
+        update_visible_type_nodes();
+    }
 
-    auto ref = utility::scan(g_framework->get_module().as<HMODULE>(), "66 C7 40 18 01 01 48 89 05 ? ? ? ?");
-    auto& l = *(std::map<uint64_t, REEnumData>*)(utility::calculate_absolute(*ref + 9));
-    spdlog::info("EnumList: {:x}", (uintptr_t)&l);
+    ImGui::Text("Click a type to display it below");
+    ImGui::BeginChild("TypeTree", ImVec2{ 0.0f, 400.0f }, true);
 
-    spdlog::info("Size: {}", l.size());
+    const auto indent = ImGui::GetTreeNodeToLabelSpacing();
 
-    for (auto& elem : l) {
-        spdlog::info(" {:x}[ {} {} ]", (uintptr_t)&elem, elem.first, elem.second.name);
+    ImGuiListClipper clipper{};
+    clipper.Begin((int)m_visible_type_nodes.size());
+
+    while (clipper.Step()) {
+        for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const auto index = m_visible_type_nodes[row];
+            auto& node = m_type_tree[index];
+            const auto is_leaf = node.end == index + 1;
+
+            ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_NoTreePushOnOpen;
+
+            if (is_leaf) {
+                flags |= ImGuiTreeNodeFlags_Leaf;
+            }
 
-        std::string name = elem.second.name;
-        std::string nspace = name.substr(0, name.find_last_of("."));
-        name = name.substr(name.find_last_of(".") + 1);
+            ImGui::SetCursorPosX(ImGui::GetCursorPosX() + node.depth * indent);
+            ImGui::SetNextTreeNodeOpen(node.expanded, ImGuiCond_Always);
 
-        for (auto pos = nspace.find("."); pos != std::string::npos; pos = nspace.find(".")) {
-            nspace.replace(pos, 1, "::");
+            const auto open = ImGui::TreeNodeEx((void*)(uintptr_t)index, flags, "%.*s", (int)node.name.size(), node.name.data());
+
+            if (node.type != nullptr && ImGui::IsItemClicked()) {
+                m_displayed_types.clear();
+                m_displayed_types.push_back(node.type);
+            }
+
+            if (!is_leaf && open != node.expanded) {
+                node.expanded = open;
+                m_type_tree_dirty = true;
+            }
         }
+    }
 
+    ImGui::EndChild();
+}
 
-        out_file << "namespace " << nspace << " {" << std::endl;
-        out_file << "    enum " << name << " {" << std::endl;
+void ObjectExplorer::draw_member_search() {
+    auto index = sdk::get_member_index();
 
-        for (auto node = elem.second.values; node != nullptr; node = node->next) {
-            if (node->name == nullptr) {
-                continue;
+    if (index == nullptr) {
+        ImGui::Text("Building member index...");
+        return;
+    }
+
+    ImGui::InputText("Member Name", m_member_name.data(), 256);
+
+    const std::string_view prefix{ m_member_name.data() };
+
+    if (prefix.empty()) {
+        return;
+    }
+
+    auto members = index->find_prefix(prefix);
+
+    ImGui::Text("%i fields/methods starting with \"%s\", click one to display its type below", (int)members.size(), m_member_name.data());
+    ImGui::BeginChild("MemberResults", ImVec2{ 0.0f, 300.0f }, true);
+
+    ImGuiListClipper clipper{};
+    clipper.Begin((int)members.size());
+
+    while (clipper.Step()) {
+        for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            auto& member = members[row];
+
+            std::string label{ member.type_name.empty() ? "undefined" : member.type_name };
+            label += ' ';
+            label += member.type->name != nullptr ? member.type->name : "";
+            label += "::";
+            label += member.name;
+
+            if (member.kind == sdk::REMemberIndex::Kind::METHOD) {
+                label += '(';
+
+                for (auto& param : index->get_params(member)) {
+                    if (label.back() != '(') {
+                        label += ", ";
+                    }
+
+                    label += param.type_name;
+                    label += ' ';
+                    label += param.name;
+                }
+
+                label += ')';
+            }
+
+            ImGui::PushID(row);
+
+            if (ImGui::Selectable(label.c_str())) {
+                m_displayed_types.clear();
+                m_displayed_types.push_back(member.type);
             }
 
-            spdlog::info("     {} = {}", node->name, node->value);
-            out_file << "        " << node->name << " = " << node->value << "," << std::endl;
+            ImGui::PopID();
+        }
+    }
+
+    ImGui::EndChild();
+}
 
-            m_enums.emplace(elem.second.name, EnumDescriptor{ node->name, node->value });
+void ObjectExplorer::draw_object_graph() {
+    if (m_object_graph_future.valid()) {
+        if (m_object_graph_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ImGui::Text("Walking...");
+            return;
         }
 
-        out_file << "    };" << std::endl;
-        out_file << "}" << std::endl;
+        m_object_graph = m_object_graph_future.get();
+        m_object_graph_types.clear();
+
+        if (m_object_graph == nullptr) {
+            spdlog::info("Member index isn't ready yet");
+        }
+        else {
+            for (auto& [t, stats] : m_object_graph->get_type_stats()) {
+                m_object_graph_types.emplace_back(t, stats);
+            }
+
+            std::sort(m_object_graph_types.begin(), m_object_graph_types.end(), [](const auto& a, const auto& b) {
+                return a.second.size > b.second.size;
+            });
+        }
+    }
+
+    // Only fields with a discovered offset are followed, the more types get expanded above the more this finds
+    if (ImGui::Button("Walk From Singletons")) {
+        auto singletons = g_framework->get_globals()->get_sorted_objects();
+
+        m_object_graph_future = std::async(std::launch::async, [singletons]() {
+            return sdk::walk_object_graph(*singletons);
+        });
+
+        return;
+    }
+
+    if (m_object_graph == nullptr) {
+        return;
+    }
+
+    auto& total = m_object_graph->get_total_stats();
+    auto& shared = m_object_graph->get_shared_stats();
+
+    ImGui::Text("%llu objects, %llu bytes. %llu objects (%llu bytes) reachable from more than one singleton.",
+        (unsigned long long)total.count, (unsigned long long)total.size, (unsigned long long)shared.count, (unsigned long long)shared.size);
+
+    if (ImGui::TreeNode("Retained By Singleton")) {
+        auto& roots = m_object_graph->get_roots();
+        auto& root_stats = m_object_graph->get_root_stats();
+
+        for (size_t i = 0; i < roots.size(); ++i) {
+            auto t = utility::re_managed_object::get_type(roots[i]);
+
+            ImGui::Text("%s: %llu objects, %llu bytes", t != nullptr ? t->name : "?",
+                (unsigned long long)root_stats[i].count, (unsigned long long)root_stats[i].size);
+        }
+
+        ImGui::TreePop();
+    }
+
+    ImGui::Text("By type, hover one for how an instance of it was reached");
+    ImGui::BeginChild("ObjectGraphTypes", ImVec2{ 0.0f, 300.0f }, true);
+
+    ImGuiListClipper clipper{};
+    clipper.Begin((int)m_object_graph_types.size());
+
+    while (clipper.Step()) {
+        for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            auto& [t, stats] = m_object_graph_types[row];
+
+            ImGui::Text("%s: %llu instances, %llu bytes", t != nullptr ? t->name : "?", (unsigned long long)stats.count, (unsigned long long)stats.size);
+
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("%s", sdk::describe_path(*m_object_graph, stats.sample).c_str());
+            }
+        }
     }
+
+    ImGui::EndChild();
 }
 
-std::string ObjectExplorer::get_enum_value_name(std::string_view enum_name, int64_t value) {
-    auto values = m_enums.equal_range(enum_name.data());
+void ObjectExplorer::draw_snapshot_diff() {
+    ImGui::Text("Watching %i objects, right click an object to add it", (int)m_watched_objects.size());
+
+    // Whole instance sets come from the last object graph walk
+    ImGui::InputText("Instances Of", m_snapshot_type_name.data(), 256);
+
+    if (ImGui::Button("Add Instances")) {
+        auto t = get_type(m_snapshot_type_name.data());
+
+        if (t == nullptr || m_object_graph == nullptr) {
+            spdlog::info("Unknown type or no object graph walked yet");
+        }
+        else {
+            auto instances = sdk::find_instances(*m_object_graph, t);
+
+            // Leave out what's already watched, clicking twice shouldn't double every capture.
+            // Both sorted, so it's one merge-like pass. The watch list keeps its order.
+            auto watched = m_watched_objects;
+            std::sort(watched.begin(), watched.end());
+
+            auto it = watched.begin();
 
-    for (auto i = values.first; i != values.second; ++i) {
-        if (i->second.value == value) {
-            return i->second.name;
+            for (auto obj : instances) {
+                it = std::lower_bound(it, watched.end(), obj);
+
+                if (it == watched.end() || *it != obj) {
+                    m_watched_objects.push_back(obj);
+                }
+            }
+        }
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Clear")) {
+        m_watched_objects.clear();
+        m_snapshot = {};
+        m_snapshot_changes.clear();
+    }
+
+    // Each capture is diffed against the one before it
+    if (ImGui::Button("Capture")) {
+        const auto start = std::chrono::steady_clock::now();
+
+        sdk::REObjectSnapshot snapshot{};
+        snapshot.capture(m_watched_objects);
+
+        const auto captured = std::chrono::steady_clock::now();
+
+        m_snapshot_changes = snapshot.diff(m_snapshot);
+        m_snapshot = std::move(snapshot);
+
+        const auto end = std::chrono::steady_clock::now();
+
+        spdlog::info("Captured {} objects in {}us, {} changes found in {}us", m_snapshot.size(),
+            std::chrono::duration_cast<std::chrono::microseconds>(captured - start).count(), m_snapshot_changes.size(),
+            std::chrono::duration_cast<std::chrono::microseconds>(end - captured).count());
+    }
+
+    if (m_snapshot_changes.empty()) {
+        return;
+    }
+
+    ImGui::Text("%i changes since the previous capture", (int)m_snapshot_changes.size());
+    ImGui::BeginChild("SnapshotChanges", ImVec2{ 0.0f, 300.0f }, true);
+
+    ImGuiListClipper clipper{};
+    clipper.Begin((int)m_snapshot_changes.size());
+
+    while (clipper.Step()) {
+        for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            auto& change = m_snapshot_changes[row];
+
+            // The object can be gone by now, only the field descriptor gets dereferenced
+            ImGui::Text("0x%p %s +0x%X (%u bytes)", change.object, change.field != nullptr ? change.field->name : "?", change.offset, change.size);
         }
     }
 
-    return "";
+    ImGui::EndChild();
+}
+
+void ObjectExplorer::update_visible_type_nodes() {
+    m_visible_type_nodes.clear();
+
+    for (uint32_t i = 0; i < m_type_tree.size();) {
+        m_visible_type_nodes.push_back(i);
+
+        // Skip over the whole subtree of collapsed nodes
+        i = m_type_tree[i].expanded ? i + 1 : m_type_tree[i].end;
+    }
+
+    m_type_tree_dirty = false;
+}
+
+std::string_view ObjectExplorer::get_enum_value_name(std::string_view enum_name, int64_t value) {
+    auto catalog = sdk::get_enum_catalog();
+
+    if (catalog == nullptr) {
+        return {};
+    }
+
+    return catalog->get_value_name(enum_name, value);
 }
 
 REType* ObjectExplorer::get_type(std::string_view type_name) {
@@ -1038,9 +1480,5 @@ REType* ObjectExplorer::get_type(std::string_view type_name) {
         return nullptr;
     }
 
-    if (auto i = m_types.find(type_name.data()); i != m_types.end()) {
-        return i->second;
-    }
-
-    return nullptr;
+    return g_framework->get_types()->find(type_name);
 }
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <atomic>
+#include <future>
+#include <memory>
 #include <unordered_set>
 
 #include <imgui/imgui.h>
 
 #include "utility/Address.hpp"
+#include "utility/CoalescingWorker.hpp"
+#include "utility/FlatMap.hpp"
+#include "utility/OffsetFinder.hpp"
+#include "utility/TrigramIndex.hpp"
+#include "sdk/REObjectGraph.hpp"
+#include "sdk/REObjectSnapshot.hpp"
 #include "Mod.hpp"
 
 class ObjectExplorer : public Mod {
@@ -27,6 +36,15 @@ private:
     void display_fields(REManagedObject* obj, REType* type_info);
     void attempt_display_field(REManagedObject* obj, VariableDescriptor* desc);
     int32_t get_field_offset(REManagedObject* obj, VariableDescriptor* desc);
+    void discover_field_offsets(REManagedObject* obj, REType* t);
+
+    // Offset discovery helpers
+    void prepare_field_getters();
+    bool call_field_getter(VariableDescriptor* desc, uint8_t* obj, uint8_t* out);
+    bool is_reference_field(VariableDescriptor* desc);
+    utility::OffsetFinder make_offset_finder(REManagedObject* obj);
+    int32_t find_field_offset(utility::OffsetFinder& finder, REManagedObject* obj, VariableDescriptor* desc);
+    void set_discovered_offset(VariableDescriptor* desc, int32_t offset);
 
     bool widget_with_context(void* address, std::function<bool()> widget);
     void context_menu(void* address);
@@ -36,9 +54,27 @@ private:
     bool is_managed_object(Address address) const;
 
     void populate_classes();
-    void populate_enums();
+    void search_types();
+    void show_type_search_results();
+    void draw_member_search();
+    void draw_object_graph();
+    void draw_snapshot_diff();
+
+    // Namespace tree for the Types view. Nodes are in pre-order, a node's subtree is [index + 1, end).
+    // A node can be a type and a namespace at the same time (nested types).
+    struct TypeTreeNode {
+        std::string_view name;
+        REType* type;
+        uint32_t end;
+        uint32_t depth;
+        bool expanded;
+    };
+
+    static std::vector<TypeTreeNode> build_type_tree(std::vector<std::string_view> names);
+    void draw_type_tree();
+    void update_visible_type_nodes();
 
-    std::string get_enum_value_name(std::string_view enum_name, int64_t value);
+    std::string_view get_enum_value_name(std::string_view enum_name, int64_t value);
     REType* get_type(std::string_view type_name);
 
     template <typename T, typename... Args>
@@ -56,20 +92,70 @@ private:
     inline static const ImVec4 VARIABLE_COLOR{ 100.0f / 255.0f, 149.0f / 255.0f, 237.0f / 255.0f, 255 / 255.0f };
     inline static const ImVec4 VARIABLE_COLOR_HIGHLIGHT{ 1.0f, 1.0f, 1.0f, 1.0f };
 
+    // Checked for every node we draw
+    sdk::RETypeRef m_game_object_type{ "via.GameObject" };
+    sdk::RETypeRef m_component_type{ "via.Component" };
+
     std::string m_type_name{ "via.typeinfo.TypeInfo" };
     std::string m_object_address{ "0" };
+    std::string m_member_name{};
     std::chrono::system_clock::time_point m_next_refresh;
 
-    std::unordered_map<VariableDescriptor*, int32_t> m_offset_map;
+    utility::FlatMap<VariableDescriptor*, int32_t> m_offset_map;
+    // Types whose fields went through discover_field_offsets already
+    utility::FlatSet<REType*> m_discovered_types;
+
+    // Views into the engine's type names, lookups go through RETypes
+    std::vector<std::string_view> m_sorted_types;
+
+    // Built in the background on first draw, then drawn with a clipper so only the visible rows cost anything
+    std::future<std::vector<TypeTreeNode>> m_type_tree_future;
+    std::vector<TypeTreeNode> m_type_tree;
+    // Indices into m_type_tree that aren't inside a collapsed node, rebuilt when something is expanded/collapsed
+    std::vector<uint32_t> m_visible_type_nodes;
+    bool m_type_tree_dirty{ true };
+
+    // Substring index over m_sorted_types for the "Type Name" box, also built in the background
+    std::future<utility::TrigramIndex> m_type_index_future;
+    std::shared_ptr<const utility::TrigramIndex> m_type_index;
+
+    // Queries against the index run on a worker so typing never waits on one.
+    // A new query cancels the one in progress, only the last one typed gets answered.
+    struct TypeSearchQuery {
+        std::shared_ptr<const utility::TrigramIndex> index;
+        std::string text;
+    };
 
-    struct EnumDescriptor {
-        std::string name;
-        int64_t value;
+    struct TypeSearchResults {
+        std::string query;
+        std::vector<std::string_view> names;
+        bool fuzzy;
     };
 
-    std::unordered_multimap<std::string, EnumDescriptor> m_enums;
-    std::unordered_map<std::string, REType*> m_types;
-    std::vector<std::string> m_sorted_types;
+    void run_type_search(TypeSearchQuery query);
+
+    // Only touched by the worker
+    utility::TrigramIndex::Search m_type_search{ 256 };
+    std::shared_ptr<const utility::TrigramIndex> m_type_search_index;
+
+    std::atomic<bool> m_type_search_cancel{ false };
+    std::shared_ptr<const TypeSearchResults> m_type_search_results;
+    // What m_displayed_types was last built from, and whether it's still waiting on an answer for the box
+    std::shared_ptr<const TypeSearchResults> m_shown_type_search_results;
+    bool m_waiting_for_type_search{ false };
+    utility::CoalescingWorker<TypeSearchQuery> m_type_search_worker{ [this](TypeSearchQuery query) { run_type_search(std::move(query)); } };
+
+    // Walked on demand in the background, the objects it points to are only valid until something frees them
+    std::future<std::unique_ptr<sdk::REObjectGraph>> m_object_graph_future;
+    std::unique_ptr<sdk::REObjectGraph> m_object_graph;
+    // Biggest first
+    std::vector<std::pair<REType*, sdk::REObjectGraph::TypeStats>> m_object_graph_types;
+
+    // Objects captured by "Snapshot Diff", and the last capture to diff the next one against
+    std::vector<REManagedObject*> m_watched_objects;
+    std::string m_snapshot_type_name{};
+    sdk::REObjectSnapshot m_snapshot;
+    std::vector<sdk::REObjectSnapshot::FieldChange> m_snapshot_changes;
 
     // Types currently being displayed
     std::vector<REType*> m_displayed_types;
@@ -9,6 +9,7 @@
 #include "utility/Module.hpp"
 
 #include "sdk/REGlobals.hpp"
+#include "sdk/REOffsetDatabase.hpp"
 #include "Mods.hpp"
 
 #include "LicenseStrings.hpp"
@@ -46,6 +47,8 @@ REFramework::~REFramework() {
 void REFramework::on_frame() {
     spdlog::debug("on_frame");
 
+    ++m_frame_count;
+
     if (!m_initialized) {
         if (!initialize()) {
             spdlog::error("Failed to initialize REFramework");
@@ -133,6 +136,11 @@ void REFramework::save_config() {
     }
 
     spdlog::info("Saved config");
+
+    // m_game_data_initialized is set after the init thread is done with it
+    if (m_game_data_initialized && m_offset_database != nullptr) {
+        m_offset_database->save();
+    }
 }
 
 void REFramework::draw_ui() {
@@ -286,6 +294,15 @@ bool REFramework::initialize() {
         std::thread init_thread([this]() {
             m_types = std::make_unique<RETypes>();
             m_globals = std::make_unique<REGlobals>();
+
+            // Finishes on its own thread, nothing at startup needs enum names
+            sdk::rebuild_enum_catalog();
+
+            // Field offsets discovered in previous sessions, loaded before save_config can see it
+            auto offset_database = std::make_unique<REOffsetDatabase>("re2_fw_offsets.bin");
+            offset_database->load();
+            m_offset_database = std::move(offset_database);
+
             m_mods = std::make_unique<Mods>();
 
             auto e = m_mods->on_initialize();
@@ -5,6 +5,7 @@
 class Mods;
 class REGlobals;
 class RETypes;
+class REOffsetDatabase;
 
 #include "D3D11Hook.hpp"
 #include "WindowsMessageHook.hpp"
@@ -36,6 +37,10 @@ public:
         return m_globals;
     }
 
+    const auto& get_offset_database() const {
+        return m_offset_database;
+    }
+
     Address get_module() const {
         return m_game_module;
     }
@@ -44,6 +49,10 @@ public:
         return m_game_data_initialized;
     }
 
+    uint32_t get_frame_count() const {
+        return m_frame_count;
+    }
+
     void on_frame();
     void on_reset();
     bool on_message(HWND wnd, UINT message, WPARAM w_param, LPARAM l_param);
@@ -64,6 +73,7 @@ private:
     bool m_initialized{ false };
     bool m_draw_ui{ true };
     std::atomic<bool> m_game_data_initialized{ false };
+    std::atomic<uint32_t> m_frame_count{ 0 };
 
     std::mutex m_input_mutex{};
     
@@ -83,6 +93,7 @@ private:
     std::unique_ptr<Mods> m_mods;
     std::unique_ptr<REGlobals> m_globals;
     std::unique_ptr<RETypes> m_types;
+    std::unique_ptr<REOffsetDatabase> m_offset_database;
 
     ID3D11RenderTargetView* m_main_render_target_view{ nullptr };
 };
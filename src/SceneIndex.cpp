@@ -0,0 +1,368 @@
+#include <spdlog/spdlog.h>
+
+#include "utility/String.hpp"
+
+#include "REFramework.hpp"
+#include "SceneIndex.hpp"
+
+SceneIndex* g_scene_index = nullptr;
+
+SceneIndex::SceneIndex() {
+    g_scene_index = this;
+}
+
+void SceneIndex::on_frame() {
+    const auto frame = g_framework->get_frame_count();
+
+    rebuild_grid(frame);
+
+    std::unique_lock _{ m_mutex };
+
+    if (m_order.empty()) {
+        return;
+    }
+
+    // Pick up components that were added after we first saw the object, and name changes.
+    // Evict whatever stopped updating while we're at it.
+    for (size_t i = 0; i < RESCAN_PER_FRAME && !m_order.empty(); ++i) {
+        if (m_rescan_cursor >= m_order.size()) {
+            m_rescan_cursor = 0;
+        }
+
+        auto transform = m_order[m_rescan_cursor];
+        auto& entry = *m_entries[transform];
+
+        // Live only means it updated recently, it can still have been freed since.
+        // Check it's still an object before reading anything out of it.
+        if (!is_live(entry, frame) || !is_valid(entry) || transform->ownerGameObject != entry.game_object) {
+            // Swaps the last entry into the cursor's slot, so don't advance
+            remove_entry(transform);
+            continue;
+        }
+
+        unindex_entry(entry);
+        index_entry(entry);
+
+        ++m_rescan_cursor;
+    }
+}
+
+void SceneIndex::on_update_transform(RETransform* transform) {
+    const auto frame = g_framework->get_frame_count();
+    auto game_object = transform->ownerGameObject;
+
+    // Only the game object's own transform, not every child/joint transform
+    const auto is_own_transform = game_object != nullptr && game_object->transform == transform;
+
+    {
+        std::shared_lock _{ m_mutex };
+
+        auto it = m_entries.find(transform);
+
+        if (it == m_entries.end() && !is_own_transform) {
+            return;
+        }
+
+        // Still the same object, otherwise the transform got reused and the entry gets replaced below
+        if (it != m_entries.end() && is_own_transform && it->second->game_object == game_object) {
+            it->second->last_seen_frame.store(frame, std::memory_order_relaxed);
+            it->second->position.store(transform->worldTransform[3]);
+            return;
+        }
+    }
+
+    std::unique_lock _{ m_mutex };
+
+    if (auto it = m_entries.find(transform); it != m_entries.end() && (!is_own_transform || it->second->game_object != game_object)) {
+        remove_entry(transform);
+    }
+
+    if (is_own_transform) {
+        add_entry(transform, game_object, frame);
+    }
+}
+
+REGameObject* SceneIndex::find_game_object(std::string_view name) const {
+    const auto frame = g_framework->get_frame_count();
+
+    std::shared_lock _{ m_mutex };
+
+    auto range = m_by_name.equal_range(utility::hash(name));
+
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->name == name && is_live(*it->second, frame)) {
+            return it->second->game_object;
+        }
+    }
+
+    return nullptr;
+}
+
+std::vector<REGameObject*> SceneIndex::find_game_objects(std::string_view name) const {
+    const auto frame = g_framework->get_frame_count();
+    std::vector<REGameObject*> out{};
+
+    std::shared_lock _{ m_mutex };
+
+    auto range = m_by_name.equal_range(utility::hash(name));
+
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->name == name && is_live(*it->second, frame)) {
+            out.push_back(it->second->game_object);
+        }
+    }
+
+    return out;
+}
+
+std::vector<REGameObject*> SceneIndex::find_game_objects_with(REType* component_type) const {
+    const auto frame = g_framework->get_frame_count();
+    std::vector<REGameObject*> out{};
+
+    std::shared_lock _{ m_mutex };
+
+    auto it = m_by_component.find(component_type);
+
+    if (it == m_by_component.end()) {
+        return out;
+    }
+
+    out.reserve(it->second.size());
+
+    for (auto entry : it->second) {
+        if (is_live(*entry, frame)) {
+            out.push_back(entry->game_object);
+        }
+    }
+
+    return out;
+}
+
+REGameObject* SceneIndex::get_game_object(RETransform* transform) const {
+    const auto frame = g_framework->get_frame_count();
+
+    std::shared_lock _{ m_mutex };
+
+    if (auto it = m_entries.find(transform); it != m_entries.end() && is_live(*it->second, frame)) {
+        return it->second->game_object;
+    }
+
+    return nullptr;
+}
+
+std::vector<REGameObject*> SceneIndex::get_game_objects() const {
+    const auto frame = g_framework->get_frame_count();
+    std::vector<REGameObject*> out{};
+
+    std::shared_lock _{ m_mutex };
+
+    out.reserve(m_entries.size());
+
+    for (auto& [transform, entry] : m_entries) {
+        if (is_live(*entry, frame)) {
+            out.push_back(entry->game_object);
+        }
+    }
+
+    return out;
+}
+
+std::vector<REGameObject*> SceneIndex::find_game_objects_near(const Vector3f& center, float radius) const {
+    std::vector<REGameObject*> out{};
+
+    std::shared_lock _{ m_grid_mutex };
+
+    m_grid.query_radius(center.x, center.y, center.z, radius, [&](const auto& item) {
+        out.push_back(item.value);
+    });
+
+    return out;
+}
+
+std::vector<REGameObject*> SceneIndex::find_game_objects_in_frustum(const Matrix4x4f& view_proj) const {
+    // Gribb/Hartmann plane extraction, glm is column major so rows are m[col][row]
+    auto row = [&](int32_t i) {
+        return Vector4f{ view_proj[0][i], view_proj[1][i], view_proj[2][i], view_proj[3][i] };
+    };
+
+    const Vector4f planes[6]{
+        row(3) + row(0), // left
+        row(3) - row(0), // right
+        row(3) + row(1), // bottom
+        row(3) - row(1), // top
+        row(2),          // near
+        row(3) - row(2), // far
+    };
+
+    utility::SpatialHash<REGameObject*>::Frustum frustum{};
+
+    for (auto i = 0; i < 6; ++i) {
+        frustum[i] = { planes[i].x, planes[i].y, planes[i].z, planes[i].w };
+    }
+
+    std::vector<REGameObject*> out{};
+
+    std::shared_lock _{ m_grid_mutex };
+
+    m_grid.query_frustum(frustum, [&](const auto& item) {
+        out.push_back(item.value);
+    });
+
+    return out;
+}
+
+size_t SceneIndex::size() const {
+    std::shared_lock _{ m_mutex };
+    return m_entries.size();
+}
+
+void SceneIndex::add_entry(RETransform* transform, REGameObject* game_object, uint32_t frame) {
+    // Someone else got here first
+    if (m_entries.count(transform) > 0) {
+        return;
+    }
+
+    auto entry = std::make_unique<Entry>();
+
+    entry->transform = transform;
+    entry->game_object = game_object;
+    entry->order_index = m_order.size();
+    entry->last_seen_frame = frame;
+    entry->position.store(transform->worldTransform[3]);
+
+    index_entry(*entry);
+
+    m_order.push_back(transform);
+    m_entries.emplace(transform, std::move(entry));
+}
+
+void SceneIndex::index_entry(Entry& entry) {
+    // Name only gets decoded here, not on every update
+    entry.name = acquire_name(utility::re_string::get_string(entry.game_object->name));
+    entry.name_hash = utility::hash(entry.name);
+
+    m_by_name.emplace(entry.name_hash, &entry);
+
+    // The transform is the head of the component chain
+    auto head = (REComponent*)entry.transform;
+    uint32_t count = 0;
+
+    for (auto comp = head; comp != nullptr && count < 0x1000; comp = comp->childComponent, ++count) {
+        if (!utility::re_managed_object::is_managed_object(comp)) {
+            break;
+        }
+
+        // Index under every parent type too, so "via.Component" style queries are a single lookup
+        for (auto t = utility::re_managed_object::get_type(comp); t != nullptr; t = t->super) {
+            if (m_by_component[t].insert(&entry).second) {
+                entry.component_types.push_back(t);
+            }
+        }
+
+        if (comp->childComponent == head) {
+            break;
+        }
+    }
+}
+
+void SceneIndex::unindex_entry(Entry& entry) {
+    auto range = m_by_name.equal_range(entry.name_hash);
+
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == &entry) {
+            m_by_name.erase(it);
+            break;
+        }
+    }
+
+    release_name(entry.name);
+    entry.name = {};
+
+    for (auto t : entry.component_types) {
+        if (auto it = m_by_component.find(t); it != m_by_component.end()) {
+            it->second.erase(&entry);
+
+            if (it->second.empty()) {
+                m_by_component.erase(it);
+            }
+        }
+    }
+
+    entry.component_types.clear();
+}
+
+void SceneIndex::remove_entry(RETransform* transform) {
+    auto it = m_entries.find(transform);
+
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    auto& entry = *it->second;
+
+    unindex_entry(entry);
+
+    // Swap and pop out of the rescan order
+    auto last = m_order.back();
+
+    m_order[entry.order_index] = last;
+    m_entries[last]->order_index = entry.order_index;
+    m_order.pop_back();
+
+    m_entries.erase(it);
+}
+
+std::string_view SceneIndex::acquire_name(std::string name) {
+    if (name.empty()) {
+        return {};
+    }
+
+    auto it = m_names.try_emplace(std::move(name), 0).first;
+    ++it->second;
+
+    return it->first;
+}
+
+void SceneIndex::release_name(std::string_view name) {
+    if (name.empty()) {
+        return;
+    }
+
+    if (auto it = m_names.find(std::string{ name }); it != m_names.end() && --it->second == 0) {
+        m_names.erase(it);
+    }
+}
+
+bool SceneIndex::is_valid(const Entry& entry) const {
+    return utility::re_managed_object::is_managed_object(entry.transform) && utility::re_managed_object::is_managed_object(entry.game_object);
+}
+
+bool SceneIndex::is_live(const Entry& entry, uint32_t frame) const {
+    return frame - entry.last_seen_frame.load(std::memory_order_relaxed) <= EVICT_AFTER_FRAMES;
+}
+
+void SceneIndex::rebuild_grid(uint32_t frame) {
+    std::vector<utility::SpatialHash<REGameObject*>::Item> items{};
+
+    {
+        std::shared_lock _{ m_mutex };
+
+        items.reserve(m_entries.size());
+
+        for (auto& [transform, entry] : m_entries) {
+            if (!is_live(*entry, frame)) {
+                continue;
+            }
+
+            const auto position = entry->position.load();
+            items.push_back({ position.x, position.y, position.z, entry->game_object });
+        }
+    }
+
+    // Build outside of both locks, then swap it in
+    utility::SpatialHash<REGameObject*> grid{ 5.0f };
+    grid.build(std::move(items));
+
+    std::unique_lock _{ m_grid_mutex };
+    m_grid = std::move(grid);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "utility/SeqLock.hpp"
+#include "utility/SpatialHash.hpp"
+
+#include "Mod.hpp"
+
+// Keeps track of every game object whose transform gets updated,
+// so they can be found by name, component type or transform without scanning anything.
+// Built incrementally from the UpdateTransform hook, objects that stop updating get evicted.
+class SceneIndex : public Mod {
+public:
+    SceneIndex();
+
+    std::string_view get_name() const override { return "SceneIndex"; };
+
+    void on_frame() override;
+    void on_update_transform(RETransform* transform) override;
+
+    // First live game object with this name, nullptr if none
+    REGameObject* find_game_object(std::string_view name) const;
+    // All live game objects with this name (names aren't unique)
+    std::vector<REGameObject*> find_game_objects(std::string_view name) const;
+    // All live game objects with a component of this type (or derived from it)
+    std::vector<REGameObject*> find_game_objects_with(REType* component_type) const;
+    REGameObject* get_game_object(RETransform* transform) const;
+
+    // Every live game object, for things that want to do their own filtering
+    std::vector<REGameObject*> get_game_objects() const;
+
+    // Proximity queries, against positions as of the start of the current frame
+    std::vector<REGameObject*> find_game_objects_near(const Vector3f& center, float radius) const;
+    // view_proj is a D3D style (0..1 depth) view * projection matrix
+    std::vector<REGameObject*> find_game_objects_in_frustum(const Matrix4x4f& view_proj) const;
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        RETransform* transform{ nullptr };
+        REGameObject* game_object{ nullptr };
+        // Points into m_names, valid for as long as the entry is indexed
+        std::string_view name{};
+        size_t name_hash{ 0 };
+        std::vector<REType*> component_types{};
+        // Position in m_order
+        size_t order_index{ 0 };
+
+        std::atomic<uint32_t> last_seen_frame{ 0 };
+        // Written from whichever thread updated the transform, read once per frame for the grid
+        utility::SeqLock<Vector4f> position{};
+    };
+
+    void add_entry(RETransform* transform, REGameObject* game_object, uint32_t frame);
+    void index_entry(Entry& entry);
+    void unindex_entry(Entry& entry);
+    void remove_entry(RETransform* transform);
+    std::string_view acquire_name(std::string name);
+    void release_name(std::string_view name);
+    bool is_valid(const Entry& entry) const;
+    bool is_live(const Entry& entry, uint32_t frame) const;
+    void rebuild_grid(uint32_t frame);
+
+    // Frames an object can go without updating before it's considered gone
+    static constexpr uint32_t EVICT_AFTER_FRAMES = 120;
+    // How many entries get their components rescanned per frame (components can be added later)
+    static constexpr size_t RESCAN_PER_FRAME = 64;
+
+    mutable std::shared_mutex m_mutex{};
+
+    std::unordered_map<RETransform*, std::unique_ptr<Entry>> m_entries{};
+    std::unordered_multimap<size_t, Entry*> m_by_name{};
+    std::unordered_map<REType*, std::unordered_set<Entry*>> m_by_component{};
+    // Names of the indexed entries and how many use each, a name goes away with its last entry.
+    // Node based, so the views entries hold don't move.
+    std::unordered_map<std::string, size_t> m_names{};
+
+    // Insertion order, for walking a few entries per frame
+    std::vector<RETransform*> m_order{};
+    size_t m_rescan_cursor{ 0 };
+
+    // Rebuilt from every live entry once per frame, has its own lock so queries don't wait on the hook
+    mutable std::shared_mutex m_grid_mutex{};
+    utility::SpatialHash<REGameObject*> m_grid{ 5.0f };
+};
+
+extern SceneIndex* g_scene_index;
@@ -1,46 +1,63 @@
 #pragma once
 
+#include "utility/ArrayView.hpp"
+
 #include "ReClass.hpp"
+#include "REArrayLayout.hpp"
 
 namespace utility::re_array {
     // Forward declarations
     static bool has_inline_elements(::REArrayBase* container);
+    static void* get_data(::REArrayBase* container);
+    static uint32_t get_element_size(::REArrayBase* container);
 
     template<typename T> static T* get_inline_element(::REArrayBase* container, int idx);
     template<typename T> static T* get_ptr_element(::REArrayBase* container, int idx);
     template<typename T> static T* get_element(::REArrayBase* container, int idx);
 
+    template<typename T> static ArrayView<T> get_inline_view(::REArrayBase* container);
+    template<typename T> static ArrayView<T*> get_ptr_view(::REArrayBase* container);
+
+    static_assert(layout::VALUE_TYPE == (uint8_t)via::clr::VMObjType::ValType);
+
     static bool has_inline_elements(::REArrayBase* container) {
-        if (container->containedType == nullptr) {
-            return false;
-        }
+        return layout::has_inline_elements(container);
+    }
 
-        return container->containedType->objectType == (uint8_t)via::clr::VMObjType::ValType;
+    static void* get_data(::REArrayBase* container) {
+        return layout::get_data(container);
+    }
+
+    static uint32_t get_element_size(::REArrayBase* container) {
+        return layout::get_element_size(container);
     }
 
     template<typename T>
     static T* get_inline_element(::REArrayBase* container, int idx) {
-        if (idx < 0 || idx >= container->numElements) {
-            return nullptr;
-        }             
-
-        auto data = Address{ REManagedObject::get_field_ptr(container) };
-        return data.get(container->info->classInfo->elementSize * idx).as<T*>();
+        return layout::get_inline_element<T>(container, idx);
     }
 
     template<typename T>
     static T* get_ptr_element(::REArrayBase* container, int idx) {
-        if (idx < 0 || idx >= container->numElements) {
-            return nullptr;
-        }
-
-        T** data = (T**)REManagedObject::get_field_ptr(container);
-        return data[idx];
+        return layout::get_ptr_element<T>(container, idx);
     }
 
     // may need more work to handle unseen cases.
-    template<typename T> 
+    template<typename T>
     static T* get_element(::REArrayBase* container, int idx) {
         return has_inline_elements(container) ? get_inline_element<T>(container, idx) : get_ptr_element<T>(container, idx);
     }
-}
\ No newline at end of file
+
+    // All elements of an array of value types as a T[].
+    // Empty if the array holds pointers or the element size doesn't match T.
+    template<typename T>
+    static ArrayView<T> get_inline_view(::REArrayBase* container) {
+        return layout::get_inline_view<T>(container);
+    }
+
+    // All elements of an array of objects as a T*[]. Elements can still be null.
+    template<typename T>
+    static ArrayView<T*> get_ptr_view(::REArrayBase* container) {
+        return layout::get_ptr_view<T>(container);
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "utility/ArrayView.hpp"
+
+// Where a managed array keeps its elements. Written against anything shaped like REArrayBase
+// (containedType pointing at a class info with objectType and elementSize, plus numElements)
+// so it doesn't need the engine headers and can be checked against synthetic arrays.
+// Use it through re_array (REArray.hpp).
+namespace utility::re_array::layout {
+    // via::clr::VMObjType::ValType
+    static constexpr uint8_t VALUE_TYPE = 5;
+
+    template <typename Container>
+    static bool has_inline_elements(const Container* container) {
+        return container->containedType != nullptr && container->containedType->objectType == VALUE_TYPE;
+    }
+
+    // Start of the elements. The offset of an object's first field sits 8 bytes in front of
+    // what its info pointer points at, same as re_managed_object::get_field_ptr.
+    static void* get_data(const void* container) {
+        uintptr_t info{};
+        memcpy(&info, container, sizeof(info));
+
+        int32_t offset{};
+        memcpy(&offset, (const void*)(info - sizeof(void*)), sizeof(offset));
+
+        return (uint8_t*)container + offset;
+    }
+
+    // Value types are stored back to back, elementSize apart. Everything else is a pointer.
+    template <typename Container>
+    static uint32_t get_element_size(const Container* container) {
+        return has_inline_elements(container) ? container->containedType->elementSize : (uint32_t)sizeof(void*);
+    }
+
+    template <typename T, typename Container>
+    static T* get_inline_element(Container* container, int idx) {
+        if (idx < 0 || idx >= container->numElements) {
+            return nullptr;
+        }
+
+        return (T*)((uint8_t*)get_data(container) + (size_t)container->containedType->elementSize * idx);
+    }
+
+    template <typename T, typename Container>
+    static T* get_ptr_element(Container* container, int idx) {
+        if (idx < 0 || idx >= container->numElements) {
+            return nullptr;
+        }
+
+        return ((T**)get_data(container))[idx];
+    }
+
+    template <typename T, typename Container>
+    static ArrayView<T> get_inline_view(Container* container) {
+        if (container == nullptr || container->numElements <= 0 || !has_inline_elements(container)) {
+            return {};
+        }
+
+        if (container->containedType->elementSize != sizeof(T)) {
+            return {};
+        }
+
+        return { (T*)get_data(container), (size_t)container->numElements };
+    }
+
+    template <typename T, typename Container>
+    static ArrayView<T*> get_ptr_view(Container* container) {
+        if (container == nullptr || container->numElements <= 0 || has_inline_elements(container)) {
+            return {};
+        }
+
+        return { (T**)get_data(container), (size_t)container->numElements };
+    }
+}
@@ -1,26 +1,224 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include "ReClass.hpp"
 
 namespace utility::re_component {
+    namespace detail {
+        // Components of a single game object, looked up by the type that was asked for.
+        // Misses are stored too (as nullptr) so a failed lookup doesn't walk the chain every frame.
+        // find(comp, name) only looks at what comes after comp in the chain, so it's keyed by where it started
+        struct StartKey {
+            ::REComponent* start;
+            ::REType* t;
+
+            bool operator==(const StartKey& other) const {
+                return start == other.start && t == other.t;
+            }
+        };
+
+        struct StartKeyHasher {
+            size_t operator()(const StartKey& key) const {
+                return std::hash<::REComponent*>{}(key.start) ^ ((uintptr_t)key.t * (size_t)0x9E3779B97F4A7C15);
+            }
+        };
+
+        // A cached hit stays good as long as the component still belongs to the game object.
+        // A miss can't be checked that cheaply, it's only trusted for MISS_FRAMES after the walk.
+        struct Entry {
+            ::REComponent* comp;
+            uint32_t frame;
+        };
+
+        static constexpr uint32_t MISS_FRAMES = 30;
+
+        struct ComponentIndex {
+            ::REComponent* head{ nullptr };
+            // Written under the shared lock by hits
+            std::atomic<uint32_t> used_frame{ 0 };
+
+            std::unordered_map<::REType*, Entry> by_type{};
+            std::unordered_map<::REType*, Entry> by_method{};
+            std::unordered_map<StartKey, Entry, StartKeyHasher> by_start{};
+        };
+
+        inline std::shared_mutex g_component_index_mutex{};
+        inline std::unordered_map<::REGameObject*, ComponentIndex> g_component_indices{};
+        // Size at which the next sweep for stale game objects happens
+        inline size_t g_component_index_limit{ 0x1000 };
+
+        static ::REComponent* find_in_chain(::REComponent* comp, ::REType* t) {
+            for (auto child = comp->childComponent; child != nullptr && child != comp; child = child->childComponent) {
+                if (sdk::is_a(utility::re_managed_object::get_type(child), t)) {
+                    return child;
+                }
+            }
+
+            return nullptr;
+        }
+
+        static bool is_valid(const Entry& entry, ::REGameObject* owner, uint32_t frame) {
+            if (entry.comp == nullptr) {
+                return frame - entry.frame < MISS_FRAMES;
+            }
+
+            return entry.comp->ownerGameObject == owner;
+        }
+
+        // What's cached for key in one of owner's maps, nullopt if nothing is or it can't be trusted anymore.
+        // Constant time and only under the shared lock, hits don't serialize each other.
+        template <typename Map, typename Key>
+        static std::optional<::REComponent*> find_cached(::REGameObject* owner, Map ComponentIndex::*map, const Key& key) {
+            const auto frame = sdk::get_frame_count();
+
+            std::shared_lock _{ g_component_index_mutex };
+            auto it = g_component_indices.find(owner);
+
+            if (it == g_component_indices.end()) {
+                return std::nullopt;
+            }
+
+            auto& index = it->second;
+
+            // A different transform is a different chain, nothing cached applies (get_index clears it)
+            if (index.head != (::REComponent*)owner->transform) {
+                return std::nullopt;
+            }
+
+            auto entry = (index.*map).find(key);
+
+            if (entry == (index.*map).end() || !is_valid(entry->second, owner, frame)) {
+                return std::nullopt;
+            }
+
+            index.used_frame.store(frame, std::memory_order_relaxed);
+
+            return entry->second.comp;
+        }
+
+        // Returns the index for the owner, throwing everything away if its chain starts somewhere else now.
+        // Must be called with the unique lock held.
+        static ComponentIndex& get_index(::REGameObject* owner) {
+            const auto frame = sdk::get_frame_count();
+            auto it = g_component_indices.find(owner);
+
+            if (it == g_component_indices.end()) {
+                // Drop game objects nobody has asked about in a while, they may not exist anymore.
+                // Only when a new one comes in, and the limit grows with whatever survives the sweep,
+                // so a map full of live game objects doesn't get swept on every insert.
+                if (g_component_indices.size() >= g_component_index_limit) {
+                    for (auto stale = g_component_indices.begin(); stale != g_component_indices.end();) {
+                        if (frame - stale->second.used_frame.load(std::memory_order_relaxed) > 60) {
+                            stale = g_component_indices.erase(stale);
+                        }
+                        else {
+                            ++stale;
+                        }
+                    }
+
+                    g_component_index_limit = std::max<size_t>(0x1000, g_component_indices.size() * 2);
+                }
+
+                it = g_component_indices.try_emplace(owner).first;
+            }
+
+            auto& index = it->second;
+            auto head = (::REComponent*)owner->transform;
+
+            if (head != index.head) {
+                index.head = head;
+                index.by_type.clear();
+                index.by_method.clear();
+                index.by_start.clear();
+            }
+
+            index.used_frame.store(frame, std::memory_order_relaxed);
+
+            return index;
+        }
+
+        template <typename Map, typename Key>
+        static void store(::REGameObject* owner, Map ComponentIndex::*map, const Key& key, ::REComponent* comp) {
+            std::unique_lock _{ g_component_index_mutex };
+            (get_index(owner).*map)[key] = Entry{ comp, sdk::get_frame_count() };
+        }
+    }
+
+    // Forget everything cached for a game object, for when it's known to be going away.
+    static void invalidate(::REGameObject* owner) {
+        std::unique_lock _{ detail::g_component_index_mutex };
+        detail::g_component_indices.erase(owner);
+    }
+
+    // Find a component of the given type on a game object, cached per game object.
+    template<typename T = ::REComponent>
+    static T* find(::REGameObject* owner, ::REType* t) {
+        if (owner == nullptr || t == nullptr || owner->transform == nullptr) {
+            return nullptr;
+        }
+
+        if (auto cached = detail::find_cached(owner, &detail::ComponentIndex::by_type, t)) {
+            return (T*)*cached;
+        }
+
+        // The transform is the head of the chain, check it as well as its children
+        auto head = (::REComponent*)owner->transform;
+        auto result = sdk::is_a(utility::re_managed_object::get_type(head), t) ? head : detail::find_in_chain(head, t);
+
+        detail::store(owner, &detail::ComponentIndex::by_type, t, result);
+
+        return (T*)result;
+    }
+
     static auto get_game_object(::REComponent* comp) {
-        return utility::re_managed_object::get_field<::REGameObject*>(comp, "GameObject");
+        static utility::re_managed_object::FieldRef<::REGameObject*> field{ "GameObject" };
+        return field.get(comp);
     }
 
     static auto get_valid(::REComponent* comp) {
-        return utility::re_managed_object::get_field<bool>(comp, "Valid");
+        static utility::re_managed_object::FieldRef<bool> field{ "Valid" };
+        return field.get(comp);
     }
 
     static auto get_chain(::REComponent* comp) {
-        return utility::re_managed_object::get_field<::REComponent*>(comp, "Chain");
+        static utility::re_managed_object::FieldRef<::REComponent*> field{ "Chain" };
+        return field.get(comp);
     }
 
     static auto get_delta_time(::REComponent* comp) {
-        return utility::re_managed_object::get_field<float>(comp, "DeltaTime");
+        static utility::re_managed_object::FieldRef<float> field{ "DeltaTime" };
+        return field.get(comp);
     }
 
     template<typename T = ::REComponent>
     static T* find(::REComponent* comp, std::string_view name) {
+        if (comp == nullptr) {
+            return nullptr;
+        }
+
+        auto owner = comp->ownerGameObject;
+
+        // Go through the per game object cache when we can, same as the walk below it starts after comp
+        if (auto t = sdk::find_type(name); t != nullptr && owner != nullptr && owner->transform != nullptr) {
+            const detail::StartKey key{ comp, t };
+
+            if (auto cached = detail::find_cached(owner, &detail::ComponentIndex::by_start, key)) {
+                return (T*)*cached;
+            }
+
+            auto result = detail::find_in_chain(comp, t);
+            detail::store(owner, &detail::ComponentIndex::by_start, key, result);
+
+            return (T*)result;
+        }
+
         for (auto child = comp->childComponent; child != nullptr && child != comp; child = child->childComponent) {
             if (utility::re_managed_object::is_a(child, name)) {
                 return (T*)child;
@@ -46,7 +244,24 @@ namespace utility::re_component {
 
         arg.info = t->classInfo;
 
-        auto ret = utility::re_managed_object::call_method(comp->ownerGameObject, "getComponent", &arg);
+        auto owner = comp->ownerGameObject;
+
+        if (owner != nullptr && owner->transform != nullptr) {
+            if (auto cached = detail::find_cached(owner, &detail::ComponentIndex::by_method, t)) {
+                return (T*)*cached;
+            }
+        }
+
+        static utility::re_managed_object::MethodRef get_component{ "getComponent" };
+        auto ret = get_component.call(owner, &arg);
+
+        if (!ret) {
+            return nullptr;
+        }
+
+        if (owner != nullptr && owner->transform != nullptr) {
+            detail::store(owner, &detail::ComponentIndex::by_method, t, (::REComponent*)ret->params.out_data);
+        }
 
         return (T *)ret->params.out_data;
     }
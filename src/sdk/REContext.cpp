@@ -43,15 +43,31 @@ namespace sdk {
         spdlog::info("[REGlobalContext::updatePointers] s_getThreadContext: {:x}", (uintptr_t)s_get_thread_context);
     }
 
+    // The engine hands out one context per thread, so only ask it once per thread.
+    thread_local REThreadContext* t_thread_context{ nullptr };
+
     REThreadContext* get_thread_context(int32_t unk /*= -1*/) {
+        if (unk == -1 && t_thread_context != nullptr) {
+            return t_thread_context;
+        }
+
         auto global_context = REGlobalContext::get();
 
         if (global_context == nullptr) {
             return nullptr;
         }
 
-        return global_context->get_thread_context(unk);
+        auto context = global_context->get_thread_context(unk);
+
+        if (unk == -1) {
+            t_thread_context = context;
+        }
+
+        return context;
     }
-}
 
+    uint32_t get_frame_count() {
+        return g_framework != nullptr ? g_framework->get_frame_count() : 0;
+    }
+}
 
@@ -21,4 +21,7 @@ namespace sdk {
     };
 
     REThreadContext* get_thread_context(int32_t unk = -1);
+
+    // Number of frames REFramework has presented, for things that sample once per frame.
+    uint32_t get_frame_count();
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+#include "utility/Scan.hpp"
+
+#include "REFramework.hpp"
+#include "REEnumCatalog.hpp"
+
+namespace sdk {
+    REEnumCatalog::REEnumCatalog(const std::map<uint64_t, REEnumData>& enums) {
+        m_enums.reserve(enums.size());
+
+        for (auto& elem : enums) {
+            if (elem.second.name == nullptr) {
+                continue;
+            }
+
+            auto& e = m_enums[elem.second.name];
+
+            e.name = elem.second.name;
+
+            for (auto node = elem.second.values; node != nullptr; node = node->next) {
+                if (node->name == nullptr) {
+                    continue;
+                }
+
+                e.values.push_back(Value{ node->value, node->name });
+            }
+
+            std::stable_sort(e.values.begin(), e.values.end(), [](const Value& a, const Value& b) {
+                return a.value < b.value;
+            });
+
+            e.dense = !e.values.empty();
+
+            for (size_t i = 1; i < e.values.size() && e.dense; ++i) {
+                e.dense = e.values[i].value == e.values[0].value + (int64_t)i;
+            }
+        }
+    }
+
+    const REEnumCatalog::Enum* REEnumCatalog::find(std::string_view enum_name) const {
+        return m_enums.find(enum_name);
+    }
+
+    std::string_view REEnumCatalog::get_value_name(std::string_view enum_name, int64_t value) const {
+        auto e = find(enum_name);
+
+        if (e == nullptr || e->values.empty()) {
+            return {};
+        }
+
+        auto& values = e->values;
+
+        if (e->dense) {
+            const auto i = value - values[0].value;
+            return i >= 0 && i < (int64_t)values.size() ? values[i].name : std::string_view{};
+        }
+
+        auto it = std::lower_bound(values.begin(), values.end(), value, [](const Value& v, int64_t x) {
+            return v.value < x;
+        });
+
+        return it != values.end() && it->value == value ? it->name : std::string_view{};
+    }
+
+    void REEnumCatalog::export_header(std::ostream& out) const {
+        for (auto& entry : m_enums.get_entries()) {
+            auto& e = entry.value;
+
+            const auto last_dot = e.name.find_last_of('.');
+            auto nspace = std::string{ e.name.substr(0, last_dot) };
+            auto name = last_dot != std::string_view::npos ? e.name.substr(last_dot + 1) : e.name;
+
+            for (auto pos = nspace.find("."); pos != std::string::npos; pos = nspace.find(".")) {
+                nspace.replace(pos, 1, "::");
+            }
+
+            out << "namespace " << nspace << " {\n";
+            out << "    enum " << name << " {\n";
+
+            for (auto& v : e.values) {
+                out << "        " << v.name << " = " << v.value << ",\n";
+            }
+
+            out << "    };\n";
+            out << "}\n";
+        }
+    }
+
+    static std::shared_ptr<const REEnumCatalog> g_enum_catalog{};
+
+    void rebuild_enum_catalog() {
+        std::thread([]() {
+            auto ref = utility::scan(g_framework->get_module().as<HMODULE>(), "66 C7 40 18 01 01 48 89 05 ? ? ? ?");
+
+            if (!ref) {
+                spdlog::error("Failed to find the enum list");
+                return;
+            }
+
+            auto& l = *(std::map<uint64_t, REEnumData>*)(utility::calculate_absolute(*ref + 9));
+            spdlog::info("EnumList: {:x}", (uintptr_t)&l);
+
+            auto catalog = std::make_shared<const REEnumCatalog>(l);
+
+            spdlog::info("Enum catalog built with {} enums", catalog->size());
+
+            std::atomic_store(&g_enum_catalog, std::move(catalog));
+        }).detach();
+    }
+
+    std::shared_ptr<const REEnumCatalog> get_enum_catalog() {
+        return std::atomic_load(&g_enum_catalog);
+    }
+
+    bool export_enum_catalog(std::string path) {
+        auto catalog = get_enum_catalog();
+
+        if (catalog == nullptr) {
+            return false;
+        }
+
+        std::thread([catalog, path = std::move(path)]() {
+            std::ofstream out_file{ path };
+            catalog->export_header(out_file);
+
+            spdlog::info("Exported {} enums to {:s}", catalog->size(), path);
+        }).detach();
+
+        return true;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "utility/NameTable.hpp"
+
+class REEnumData;
+
+namespace sdk {
+    // Every enum the engine registers, with each enum's values sorted for lookups.
+    // Built on a worker thread, names point into engine memory.
+    class REEnumCatalog {
+    public:
+        struct Value {
+            int64_t value;
+            std::string_view name;
+        };
+
+        struct Enum {
+            std::string_view name;
+            // Sorted by value, duplicates keep their declaration order
+            std::vector<Value> values;
+            // Values are 0..n-1 (or any other run without gaps), the value is the index then
+            bool dense;
+        };
+
+        REEnumCatalog(const std::map<uint64_t, REEnumData>& enums);
+
+        const Enum* find(std::string_view enum_name) const;
+
+        // Empty if the enum or the value isn't known
+        std::string_view get_value_name(std::string_view enum_name, int64_t value) const;
+
+        // What used to be dumped to Enums_Internal.hpp, written as it goes
+        void export_header(std::ostream& out) const;
+
+        size_t size() const {
+            return m_enums.size();
+        }
+
+        // In the engine's order
+        const auto& get_enums() const {
+            return m_enums.get_entries();
+        }
+
+    private:
+        utility::NameTable<Enum> m_enums;
+    };
+
+    // Scan for the engine's enum list and build the catalog on a worker thread.
+    void rebuild_enum_catalog();
+    // null until the build finishes
+    std::shared_ptr<const REEnumCatalog> get_enum_catalog();
+
+    // Stream the catalog to a header on a worker thread. Returns false if the catalog isn't built yet.
+    bool export_enum_catalog(std::string path);
+}
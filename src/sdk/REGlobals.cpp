@@ -6,6 +6,22 @@
 #include "REFramework.hpp"
 #include "REGlobals.hpp"
 
+// Type of the object a global points to, nullptr if it isn't (yet) a usable object
+static REType* get_singleton_type(REManagedObject* obj) {
+    // Make sure the pointer is aligned on an 8-byte boundary.
+    if (obj == nullptr || ((uintptr_t)obj & (sizeof(void*) - 1)) != 0) {
+        return nullptr;
+    }
+
+    auto t = utility::re_managed_object::safe_get_type(obj);
+
+    if (t == nullptr || t->name == nullptr) {
+        return nullptr;
+    }
+
+    return t;
+}
+
 REGlobals::REGlobals() {
     spdlog::info("REGlobals initialization");
 
@@ -31,11 +47,10 @@ REGlobals::REGlobals() {
 
         auto obj_ptr = (REManagedObject**)ptr;
 
-        if (m_objects.find(obj_ptr) != m_objects.end()) {
+        if (!m_objects.insert(obj_ptr)) {
             continue;
         }
-        
-        m_objects.insert(obj_ptr);
+
         m_object_list.push_back(obj_ptr);
     }
 
@@ -46,7 +61,7 @@ REManagedObject* REGlobals::get(std::string_view name) {
     std::lock_guard _{ m_map_mutex };
 
     auto get_obj = [&]() -> REManagedObject* {
-        if (auto it = m_object_map.find(name.data()); it != m_object_map.end()) {
+        if (auto it = m_object_map.find(name); it != m_object_map.end()) {
             return *it->second;
         }
 
@@ -74,8 +89,63 @@ void REGlobals::safe_refresh() {
     refresh_map();
 }
 
+std::shared_ptr<const REGlobals::SingletonList> REGlobals::get_sorted_objects() {
+    std::lock_guard _{ m_map_mutex };
+
+    auto changed = m_sorted_objects == nullptr || m_sorted_object_values.size() != m_object_list.size();
+
+    // An object a global still points to is still alive, so its type can't have changed under us.
+    // Only a different pointer needs validating again.
+    for (size_t i = 0; i < m_object_list.size() && !changed; ++i) {
+        changed = *m_object_list[i] != m_sorted_object_values[i];
+    }
+
+    // Objects that didn't have a usable type last time (still being constructed, usually) get another look
+    for (size_t i = 0; i < m_unresolved_objects.size() && !changed; ++i) {
+        changed = get_singleton_type(*m_object_list[m_unresolved_objects[i]]) != nullptr;
+    }
+
+    if (changed) {
+        rebuild_sorted_objects();
+    }
+
+    return m_sorted_objects;
+}
+
+void REGlobals::rebuild_sorted_objects() {
+    auto singletons = std::make_shared<SingletonList>();
+
+    m_sorted_object_values.resize(m_object_list.size());
+    m_unresolved_objects.clear();
+
+    for (size_t i = 0; i < m_object_list.size(); ++i) {
+        auto obj_ptr = m_object_list[i];
+        auto obj = *obj_ptr;
+
+        m_sorted_object_values[i] = obj;
+
+        auto t = get_singleton_type(obj);
+
+        if (t == nullptr) {
+            if (obj != nullptr) {
+                m_unresolved_objects.push_back(i);
+            }
+
+            continue;
+        }
+
+        singletons->push_back(Singleton{ obj_ptr, obj, t, t->name });
+    }
+
+    std::sort(singletons->begin(), singletons->end(), [](const Singleton& a, const Singleton& b) {
+        return a.name < b.name;
+    });
+
+    m_sorted_objects = std::move(singletons);
+}
+
 void REGlobals::refresh_map() {
-    for (auto obj_ptr : m_objects) {
+    for (auto obj_ptr : m_object_list) {
         auto obj = *obj_ptr;
 
         // Make sure the pointer is aligned on an 8-byte boundary.
@@ -93,13 +163,12 @@ void REGlobals::refresh_map() {
             continue;
         }
 
-        if (m_acknowledged_objects.find(obj_ptr) == m_acknowledged_objects.end()) {
+        if (m_acknowledged_objects.insert(obj_ptr)) {
 #ifdef DEVELOPER
             spdlog::info("{:x}->{:x} ({:s})", (uintptr_t)obj_ptr, (uintptr_t)*obj_ptr, t->name);
 #endif
-            m_acknowledged_objects.insert(obj_ptr);
         }
 
-        m_object_map[t->name] = obj_ptr;
+        m_object_map.insert_or_assign(std::string_view{ t->name }, obj_ptr);
     }
 }
@@ -1,14 +1,25 @@
 #pragma once
 
+#include <memory>
 #include <mutex>
-#include <unordered_map>
-#include <unordered_set>
+
+#include "utility/FlatMap.hpp"
 
 #include "ReClass.hpp"
 
 // A list of globals in the RE engine (singletons?)
 class REGlobals {
 public:
+    // A global that held a valid object the last time we looked, with its type resolved
+    struct Singleton {
+        REManagedObject** ptr;
+        REManagedObject* obj;
+        REType* type;
+        std::string_view name;
+    };
+
+    using SingletonList = std::vector<Singleton>;
+
     REGlobals();
     virtual ~REGlobals() {};
 
@@ -32,17 +43,30 @@ public:
     // Lock a mutex and then refresh the map.
     void safe_refresh();
 
+    // The valid singletons sorted by type name. Checking for changes is one load per global,
+    // the list is only validated and sorted again when one of them points somewhere else
+    // or one that had no usable type before has one now.
+    std::shared_ptr<const SingletonList> get_sorted_objects();
+
 private:
     void refresh_map();
+    void rebuild_sorted_objects();
 
     // Class name to object like "app.foo.bar" -> 0xDEADBEEF
-    std::unordered_map<std::string, REManagedObject**> m_object_map;
+    // Keyed by the type's own name string in engine memory.
+    utility::FlatMap<std::string_view, REManagedObject**> m_object_map;
 
     // Raw list of objects (for if the type hasn't been fully initialized, we need to refresh the map)
-    std::unordered_set<REManagedObject**> m_objects;
+    utility::FlatSet<REManagedObject**> m_objects;
     std::vector<REManagedObject**> m_object_list;
     // List of objects we've already logged
-    std::unordered_set<REManagedObject**> m_acknowledged_objects;
+    utility::FlatSet<REManagedObject**> m_acknowledged_objects;
+
+    std::shared_ptr<const SingletonList> m_sorted_objects{};
+    // What each global in m_object_list pointed to when m_sorted_objects was built
+    std::vector<REManagedObject*> m_sorted_object_values{};
+    // Indices into m_object_list of globals that held an object without a usable type at that point
+    std::vector<size_t> m_unresolved_objects{};
 
     std::mutex m_map_mutex{};
 };
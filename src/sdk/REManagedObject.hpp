@@ -1,23 +1,35 @@
 #pragma once
 
 #include <windows.h>
+#include <atomic>
+#include <cstring>
 #include <mutex>
 #include <memory>
+#include <optional>
+#include <shared_mutex>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "utility/Address.hpp"
+#include "utility/FlatMap.hpp"
+#include "utility/String.hpp"
 
 #include "ReClass.hpp"
 
 namespace utility::re_managed_object {
     // Forward declarations
     struct ParamWrapper;
+    struct FieldBinding;
+    struct MethodBinding;
     static bool is_managed_object(Address address);
 
     // Check object type name
     static bool is_a(::REManagedObject* object, std::string_view name);
     // Check object type
     static bool is_a(::REManagedObject* object, REType* cmp);
+    // Check object type through a cached type handle
+    static bool is_a(::REManagedObject* object, const sdk::RETypeRef& cmp);
 
     // Get full type information about the object
     static REType* get_type(::REManagedObject* object);
@@ -36,6 +48,25 @@ namespace utility::re_managed_object {
 
     // Get a field descriptor by name
     static VariableDescriptor* get_field_desc(::REManagedObject* obj, std::string_view field);
+    static VariableDescriptor* get_field_desc(::REType* t, std::string_view field);
+
+    // Get the cached descriptor + getter for a field on a specific type.
+    // The returned pointer stays valid forever, the descriptor inside it can be null.
+    static const FieldBinding* get_field_binding(::REType* t, std::string_view field);
+
+    // Read a field through a binding, using a direct load once its offset is verified.
+    template <typename T>
+    static T read_field(const FieldBinding* binding, ::REManagedObject* obj);
+
+    // Tell the framework where a field lives inside its object (ObjectExplorer can work these out).
+    // Bindings of the field compare the offset against the getter for a while before switching to it.
+    // verified is for offsets that already went through that before (the offset database).
+    static void set_field_offset(VariableDescriptor* desc, int32_t offset, bool verified = false);
+    static std::optional<int32_t> get_field_offset(VariableDescriptor* desc);
+    // Copy of every known offset
+    static std::unordered_map<VariableDescriptor*, int32_t> get_field_offsets();
+    // Only the ones a binding has confirmed against the getter
+    static std::unordered_map<VariableDescriptor*, int32_t> get_verified_field_offsets();
 
     // Gets the base offset of the top class in the hierarchy for this object
     template <typename T>
@@ -46,19 +77,299 @@ namespace utility::re_managed_object {
     template <typename T>
     T get_field(::REManagedObject* obj, std::string_view field);
     
+    // Get a method descriptor by name
+    static FunctionDescriptor* get_method_desc(::REManagedObject* obj, std::string_view name);
+    static FunctionDescriptor* get_method_desc(::REType* t, std::string_view name);
+
+    // Same as get_field_binding, but for methods.
+    static const MethodBinding* get_method_binding(::REType* t, std::string_view name);
+
+    // The parameter block lives on the stack, nothing is allocated per call.
+    template <typename Arg>
+    static std::optional<ParamWrapper> call_method(::REManagedObject* obj, std::string_view name, const Arg& arg);
     template <typename Arg>
-    static std::unique_ptr<ParamWrapper> call_method(::REManagedObject* obj, std::string_view name, const Arg& arg);
+    static std::optional<ParamWrapper> call_method(const MethodBinding* binding, ::REManagedObject* obj, const Arg& arg);
+
+    using FieldGetter = void* (*)(VariableDescriptor*, ::REManagedObject*, void*);
+    using MethodFunction = void* (*)(MethodParams*, ::REThreadContext*);
 
     struct ParamWrapper {
         ParamWrapper(::REManagedObject* obj) {
             params.object_ptr = (void*)obj;
         }
 
-        virtual ~ParamWrapper() {}
-
         MethodParams params{};
     };
 
+    enum class FieldAccessMode : uint8_t {
+        // Always call the getter
+        GETTER,
+        // Call the getter and compare against known offsets, but never switch
+        VERIFY,
+        // Switch to a direct load once an offset has been verified
+        DIRECT,
+    };
+
+    // How many frames a known offset has to match the getter before it's used on its own.
+    static constexpr uint32_t FIELD_OFFSET_VERIFY_FRAMES = 60;
+
+    // A field resolved against one concrete type.
+    struct FieldBinding {
+        FieldBinding(::REType* t, VariableDescriptor* d, FieldGetter g)
+            : type{ t },
+            desc{ d },
+            getter{ g }
+        {
+        }
+
+        ::REType* type{ nullptr };
+        VariableDescriptor* desc{ nullptr };
+        FieldGetter getter{ nullptr };
+
+        // Offset we read from directly, only set after verification. 0 == use the getter.
+        mutable std::atomic<int32_t> direct_offset{ 0 };
+        // Offset currently being compared against the getter. 0 == nothing to verify.
+        mutable std::atomic<int32_t> candidate_offset{ 0 };
+        mutable std::atomic<uint32_t> verified_frames{ 0 };
+        mutable std::atomic<uint32_t> last_verified_frame{ 0 };
+        // Constant values can't prove anything, we need to see the field change at least once.
+        mutable std::atomic<size_t> last_value_hash{ 0 };
+        mutable std::atomic<bool> value_changed{ false };
+        // The candidate made it through verification and got reported as such
+        mutable std::atomic<bool> verified{ false };
+    };
+
+    // Pre-bound field accessor. Resolves the field once per type and keeps
+    // the descriptor and getter, so reading it afterwards is one indirect call
+    // with no allocations or string compares.
+    // The name must outlive the FieldRef, string literals are what it's meant for.
+    // The constructor is constexpr so function-local statics don't need an init guard.
+    template <typename T>
+    class FieldRef {
+    public:
+        constexpr FieldRef(std::string_view name)
+            : m_name{ name }
+        {
+        }
+
+        // Be very careful with the type size here, stack corruption could occur if the size is not large enough!
+        T get(::REManagedObject* obj) {
+            return read_field<T>(resolve(obj), obj);
+        }
+
+        T operator()(::REManagedObject* obj) {
+            return get(obj);
+        }
+
+        VariableDescriptor* get_desc(::REManagedObject* obj) {
+            auto binding = resolve(obj);
+            return binding != nullptr ? binding->desc : nullptr;
+        }
+
+        const auto& get_name() const {
+            return m_name;
+        }
+
+    private:
+        const FieldBinding* resolve(::REManagedObject* obj) {
+            auto t = get_type(obj);
+
+            if (t == nullptr) {
+                return nullptr;
+            }
+
+            auto binding = m_binding.load(std::memory_order_acquire);
+
+            // Objects of a different type (or a subclass) can come through here, rebind.
+            if (binding == nullptr || binding->type != t) {
+                binding = get_field_binding(t, m_name);
+                m_binding.store(binding, std::memory_order_release);
+            }
+
+            return binding;
+        }
+
+        std::string_view m_name;
+        std::atomic<const FieldBinding*> m_binding{ nullptr };
+    };
+
+    // A method resolved against one concrete type.
+    struct MethodBinding {
+        ::REType* type{ nullptr };
+        FunctionDescriptor* desc{ nullptr };
+        MethodFunction function{ nullptr };
+    };
+
+    // Pre-bound method handle, the MethodRef counterpart of FieldRef.
+    class MethodRef {
+    public:
+        constexpr MethodRef(std::string_view name)
+            : m_name{ name }
+        {
+        }
+
+        template <typename Arg>
+        std::optional<ParamWrapper> call(::REManagedObject* obj, const Arg& arg) {
+            return call_method(resolve(obj), obj, arg);
+        }
+
+        FunctionDescriptor* get_desc(::REManagedObject* obj) {
+            auto binding = resolve(obj);
+            return binding != nullptr ? binding->desc : nullptr;
+        }
+
+        const auto& get_name() const {
+            return m_name;
+        }
+
+    private:
+        const MethodBinding* resolve(::REManagedObject* obj) {
+            auto t = get_type(obj);
+
+            if (t == nullptr) {
+                return nullptr;
+            }
+
+            auto binding = m_binding.load(std::memory_order_acquire);
+
+            if (binding == nullptr || binding->type != t) {
+                binding = get_method_binding(t, m_name);
+                m_binding.store(binding, std::memory_order_release);
+            }
+
+            return binding;
+        }
+
+        std::string_view m_name;
+        std::atomic<const MethodBinding*> m_binding{ nullptr };
+    };
+
+    namespace detail {
+        // What lookups pass in, nothing gets copied until we insert
+        struct MemberKeyView {
+            ::REType* type;
+            std::string_view name;
+        };
+
+        // (type, member name). The name is kept so two names with the same hash can't share a binding.
+        struct MemberKey {
+            MemberKey() = default;
+            MemberKey(const MemberKeyView& view)
+                : type{ view.type },
+                name{ view.name }
+            {
+            }
+
+            ::REType* type{ nullptr };
+            std::string name{};
+        };
+
+        struct MemberKeyHasher {
+            template <typename Key>
+            size_t operator()(const Key& key) const {
+                return utility::hash(std::string_view{ key.name }) ^ ((uintptr_t)key.type * (size_t)0x9E3779B97F4A7C15);
+            }
+        };
+
+        struct MemberKeyEq {
+            template <typename Key>
+            bool operator()(const MemberKey& a, const Key& b) const {
+                return a.type == b.type && std::string_view{ a.name } == std::string_view{ b.name };
+            }
+        };
+
+        // Values are never erased and sit behind a unique_ptr, so pointers to them stay valid across rehashes.
+        template <typename T>
+        struct MemberCache {
+            std::shared_mutex mutex{};
+            utility::FlatMap<MemberKey, std::unique_ptr<T>, MemberKeyHasher, MemberKeyEq> map{};
+        };
+
+        // Namespace scope instead of function statics, we build with /Zc:threadSafeInit-.
+        inline MemberCache<FieldBinding> g_field_cache{};
+        inline MemberCache<MethodBinding> g_method_cache{};
+
+        // Known field offsets, fed by ObjectExplorer or anything else that works them out.
+        inline std::shared_mutex g_field_offset_mutex{};
+        inline std::unordered_map<VariableDescriptor*, int32_t> g_field_offsets{};
+        // Entries of g_field_offsets that matched the getter long enough, only these get saved
+        inline std::unordered_set<VariableDescriptor*> g_verified_field_offsets{};
+
+        inline std::atomic<FieldAccessMode> g_field_access_mode{ FieldAccessMode::DIRECT };
+
+        // Hashes the bytes the getter gave us, to notice the value changing between frames.
+        static size_t hash_bytes(const void* data, size_t size) {
+            return utility::hash(std::string_view{ (const char*)data, size });
+        }
+
+        // A known offset turned out wrong, forget it so new bindings (and the offset database) don't pick it up again
+        static void reject_field_offset(VariableDescriptor* desc, int32_t offset) {
+            std::unique_lock _{ g_field_offset_mutex };
+
+            if (auto it = g_field_offsets.find(desc); it != g_field_offsets.end() && it->second == offset) {
+                g_field_offsets.erase(it);
+                g_verified_field_offsets.erase(desc);
+            }
+        }
+
+        static void accept_field_offset(VariableDescriptor* desc, int32_t offset) {
+            std::unique_lock _{ g_field_offset_mutex };
+
+            if (auto it = g_field_offsets.find(desc); it != g_field_offsets.end() && it->second == offset) {
+                g_verified_field_offsets.insert(desc);
+            }
+        }
+
+        static void verify_field_offset(const FieldBinding* binding, ::REManagedObject* obj, const void* value, size_t size) {
+            const auto offset = binding->candidate_offset.load(std::memory_order_relaxed);
+
+            if (offset <= 0) {
+                return;
+            }
+
+            // Out of bounds or different from what the getter gave us, throw it away.
+            if (offset + size > binding->type->size || memcmp(Address{ obj }.get(offset).ptr(), value, size) != 0) {
+                binding->candidate_offset.store(0, std::memory_order_relaxed);
+                reject_field_offset(binding->desc, offset);
+                return;
+            }
+
+            // One sample per frame
+            const auto frame = sdk::get_frame_count();
+
+            if (binding->last_verified_frame.exchange(frame, std::memory_order_relaxed) == frame) {
+                return;
+            }
+
+            const auto value_hash = hash_bytes(value, size);
+
+            if (binding->last_value_hash.exchange(value_hash, std::memory_order_relaxed) != value_hash && binding->verified_frames.load(std::memory_order_relaxed) > 0) {
+                binding->value_changed.store(true, std::memory_order_relaxed);
+            }
+
+            const auto frames = binding->verified_frames.fetch_add(1, std::memory_order_relaxed) + 1;
+
+            if (frames < FIELD_OFFSET_VERIFY_FRAMES || !binding->value_changed.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            if (!binding->verified.exchange(true, std::memory_order_relaxed)) {
+                accept_field_offset(binding->desc, offset);
+            }
+
+            if (g_field_access_mode.load(std::memory_order_relaxed) == FieldAccessMode::DIRECT) {
+                binding->direct_offset.store(offset, std::memory_order_release);
+            }
+        }
+
+        static void set_candidate_offset(const FieldBinding& binding, int32_t offset) {
+            binding.verified_frames.store(0, std::memory_order_relaxed);
+            binding.value_changed.store(false, std::memory_order_relaxed);
+            binding.verified.store(false, std::memory_order_relaxed);
+            binding.candidate_offset.store(offset, std::memory_order_relaxed);
+        }
+    }
+
     static bool is_managed_object(Address address) {
         if (address == nullptr) {
             return false;
@@ -134,6 +445,11 @@ namespace utility::re_managed_object {
             return false;
         }
 
+        // Resolve the name once and let the hierarchy table do the work
+        if (auto cmp = sdk::find_type(name); cmp != nullptr) {
+            return sdk::is_a(re_managed_object::get_type(object), cmp);
+        }
+
         for (auto t = re_managed_object::get_type(object); t != nullptr && t->name != nullptr; t = t->super) {
             if (name == t->name) {
                 return true;
@@ -148,13 +464,19 @@ namespace utility::re_managed_object {
             return false;
         }
 
-        for (auto t = re_managed_object::get_type(object); t != nullptr && t->name != nullptr; t = t->super) {
-            if (cmp == t) {
-                return true;
-            }
+        return sdk::is_a(re_managed_object::get_type(object), cmp);
+    }
+
+    static bool is_a(::REManagedObject* object, const sdk::RETypeRef& cmp) {
+        if (object == nullptr) {
+            return false;
         }
 
-        return false;
+        if (auto t = cmp.get(); t != nullptr) {
+            return sdk::is_a(re_managed_object::get_type(object), t);
+        }
+
+        return is_a(object, cmp.get_name());
     }
 
 
@@ -193,10 +515,9 @@ namespace utility::re_managed_object {
         case via::clr::VMObjType::Array:
         {
             auto container = (::REArrayBase*)object;
-            auto contained_type = container->containedType;
-            
+
             // array of ptrs by default
-            uint32_t element_size = utility::re_array::has_inline_elements(container) ? contained_type->elementSize : sizeof(void*);
+            uint32_t element_size = utility::re_array::get_element_size(container);
 
             if (container->num1 <= 1) {
                 size = element_size * container->numElements + sizeof(::REArrayBase);
@@ -240,19 +561,17 @@ namespace utility::re_managed_object {
     }
 
     static VariableDescriptor* get_field_desc(::REManagedObject* obj, std::string_view field) {
-        static std::mutex insertion_mutex{};
-        static std::unordered_map<std::string, VariableDescriptor*> var_map{};
-        
-        auto t = get_type(obj);
-
-        if (t == nullptr) {
-            return nullptr;
-        }
+        auto binding = get_field_binding(get_type(obj), field);
 
-        auto full_name = std::string{ t->name } + "." + field.data();
+        return binding != nullptr ? binding->desc : nullptr;
+    }
 
-        if (var_map.find(full_name) != var_map.end()) {
-            return var_map[full_name];
+    // Uncached lookup, walks the super chain
+    static VariableDescriptor* get_field_desc(::REType* t, std::string_view field) {
+        // One lookup per parent instead of scanning every field, once the index has this type
+        if (auto index = sdk::get_member_index(); index != nullptr && index->contains(t)) {
+            auto member = index->find_field(t, field);
+            return member != nullptr ? member->field : nullptr;
         }
 
         for (; t != nullptr; t = t->super) {
@@ -270,8 +589,6 @@ namespace utility::re_managed_object {
                 }
 
                 if (field == var->name) {
-                    std::lock_guard _{ insertion_mutex };
-                    var_map[full_name] = var;
                     return var;
                 }
             }
@@ -280,17 +597,157 @@ namespace utility::re_managed_object {
         return nullptr;
     }
 
-    static FunctionDescriptor* get_method_desc(::REManagedObject* obj, std::string_view name) {
-        static std::mutex insertion_mutex{};
-        static std::unordered_map<std::string, FunctionDescriptor*> var_map{};
-
-        auto t = get_type(obj);
-
+    static const FieldBinding* get_field_binding(::REType* t, std::string_view field) {
         if (t == nullptr) {
             return nullptr;
         }
 
-        auto full_name = std::string{ t->name } + "." + name.data();
+        auto& cache = detail::g_field_cache;
+        const detail::MemberKeyView key{ t, field };
+
+        {
+            std::shared_lock _{ cache.mutex };
+
+            if (auto it = cache.map.find(key); it != cache.map.end()) {
+                return it->second.get();
+            }
+        }
+
+        // Resolve outside of the lock, misses are cached too so we don't walk the type again.
+        auto desc = get_field_desc(t, field);
+        auto getter = desc != nullptr ? (FieldGetter)desc->function : nullptr;
+        auto known_offset = desc != nullptr ? get_field_offset(desc) : std::nullopt;
+
+        std::unique_lock _{ cache.mutex };
+        auto [it, inserted] = cache.map.try_emplace(key);
+
+        if (inserted) {
+            it->second = std::make_unique<FieldBinding>(t, desc, getter);
+
+            if (known_offset) {
+                detail::set_candidate_offset(*it->second, *known_offset);
+            }
+        }
+
+        return it->second.get();
+    }
+
+    static void set_field_offset(VariableDescriptor* desc, int32_t offset, bool verified) {
+        if (desc == nullptr || offset <= 0) {
+            return;
+        }
+
+        {
+            std::unique_lock _{ detail::g_field_offset_mutex };
+
+            if (verified) {
+                detail::g_verified_field_offsets.insert(desc);
+            }
+
+            if (auto it = detail::g_field_offsets.find(desc); it != detail::g_field_offsets.end() && it->second == offset) {
+                return;
+            }
+
+            detail::g_field_offsets[desc] = offset;
+
+            if (!verified) {
+                detail::g_verified_field_offsets.erase(desc);
+            }
+        }
+
+        // Hand it to the bindings that already exist for this field.
+        std::shared_lock _{ detail::g_field_cache.mutex };
+
+        for (auto& it : detail::g_field_cache.map) {
+            auto& binding = *it.second;
+
+            if (binding.desc == desc && binding.direct_offset.load() != offset) {
+                binding.direct_offset.store(0);
+                detail::set_candidate_offset(binding, offset);
+            }
+        }
+    }
+
+    static std::optional<int32_t> get_field_offset(VariableDescriptor* desc) {
+        std::shared_lock _{ detail::g_field_offset_mutex };
+
+        if (auto it = detail::g_field_offsets.find(desc); it != detail::g_field_offsets.end()) {
+            return it->second;
+        }
+
+        return std::nullopt;
+    }
+
+    static std::unordered_map<VariableDescriptor*, int32_t> get_field_offsets() {
+        std::shared_lock _{ detail::g_field_offset_mutex };
+        return detail::g_field_offsets;
+    }
+
+    static std::unordered_map<VariableDescriptor*, int32_t> get_verified_field_offsets() {
+        std::shared_lock _{ detail::g_field_offset_mutex };
+
+        std::unordered_map<VariableDescriptor*, int32_t> result{};
+
+        for (auto desc : detail::g_verified_field_offsets) {
+            result.emplace(desc, detail::g_field_offsets.at(desc));
+        }
+
+        return result;
+    }
+
+    static void set_field_access_mode(FieldAccessMode mode) {
+        detail::g_field_access_mode = mode;
+
+        if (mode == FieldAccessMode::DIRECT) {
+            return;
+        }
+
+        // Back to the getters
+        std::shared_lock _{ detail::g_field_cache.mutex };
+
+        for (auto& it : detail::g_field_cache.map) {
+            it.second->direct_offset.store(0);
+        }
+    }
+
+    static FieldAccessMode get_field_access_mode() {
+        return detail::g_field_access_mode;
+    }
+
+    template <typename T>
+    static T read_field(const FieldBinding* binding, ::REManagedObject* obj) {
+        T data{};
+
+        if (binding == nullptr || binding->getter == nullptr) {
+            return data;
+        }
+
+        if (auto offset = binding->direct_offset.load(std::memory_order_acquire); offset > 0) {
+            memcpy(&data, Address{ obj }.get(offset).ptr(), sizeof(T));
+            return data;
+        }
+
+        binding->getter(binding->desc, obj, &data);
+
+        if (binding->candidate_offset.load(std::memory_order_relaxed) > 0 && detail::g_field_access_mode.load(std::memory_order_relaxed) != FieldAccessMode::GETTER) {
+            detail::verify_field_offset(binding, obj, &data, sizeof(T));
+        }
+
+        return data;
+    }
+
+    static FunctionDescriptor* get_method_desc(::REManagedObject* obj, std::string_view name) {
+        auto binding = get_method_binding(get_type(obj), name);
+
+        return binding != nullptr ? binding->desc : nullptr;
+    }
+
+    // Uncached lookup, walks the super chain
+    static FunctionDescriptor* get_method_desc(::REType* t, std::string_view name) {
+        if (auto index = sdk::get_member_index(); index != nullptr && index->contains(t)) {
+            auto member = index->find_method(t, name);
+            return member != nullptr ? member->method : nullptr;
+        }
 
         for (; t != nullptr; t = t->super) {
             auto fields = t->fields;
@@ -315,8 +772,6 @@ namespace utility::re_managed_object {
                 }
 
                 if (name == holder.descriptor->name) {
-                    std::lock_guard _{ insertion_mutex };
-                    var_map[full_name] = holder.descriptor;
                     return holder.descriptor;
                 }
             }
@@ -325,41 +780,59 @@ namespace utility::re_managed_object {
         return nullptr;
     }
 
-    template <typename T>
-    T get_field(::REManagedObject* obj, std::string_view field) {
-        T data{};
+    static const MethodBinding* get_method_binding(::REType* t, std::string_view name) {
+        if (t == nullptr) {
+            return nullptr;
+        }
 
-        auto desc = get_field_desc(obj, field);
+        auto& cache = detail::g_method_cache;
+        const detail::MemberKeyView key{ t, name };
 
-        if (desc != nullptr) {
-            auto get_value_func = (void* (*)(VariableDescriptor*, ::REManagedObject*, void*))desc->function;
+        {
+            std::shared_lock _{ cache.mutex };
 
-            if (get_value_func != nullptr) {
-                get_value_func(desc, obj, &data);
+            if (auto it = cache.map.find(key); it != cache.map.end()) {
+                return it->second.get();
             }
         }
 
-        return data;
-    }
+        MethodBinding binding{ t, get_method_desc(t, name), nullptr };
 
-    template <typename Arg>
-    std::unique_ptr<ParamWrapper> call_method(::REManagedObject* obj, std::string_view name, const Arg& arg) {
-        auto desc = get_method_desc(obj, name);
+        if (binding.desc != nullptr) {
+            binding.function = (MethodFunction)binding.desc->functionPtr;
+        }
 
-        if (desc != nullptr) {
+        std::unique_lock _{ cache.mutex };
+        auto [it, inserted] = cache.map.try_emplace(key);
 
-            auto methodFunc = (ParamWrapper* (*)(MethodParams*, ::REThreadContext*))desc->functionPtr;
+        if (inserted) {
+            it->second = std::make_unique<MethodBinding>(binding);
+        }
 
-            if (methodFunc != nullptr) {
-                auto params = std::make_unique<ParamWrapper>(obj);
-                
-                params->params.in_data = (void***)&arg;
+        return it->second.get();
+    }
 
-                methodFunc(&params->params, sdk::get_thread_context());
-                return std::move(params);
-            }
+    template <typename T>
+    T get_field(::REManagedObject* obj, std::string_view field) {
+        return read_field<T>(get_field_binding(get_type(obj), field), obj);
+    }
+
+    template <typename Arg>
+    std::optional<ParamWrapper> call_method(::REManagedObject* obj, std::string_view name, const Arg& arg) {
+        return call_method(get_method_binding(get_type(obj), name), obj, arg);
+    }
+
+    template <typename Arg>
+    std::optional<ParamWrapper> call_method(const MethodBinding* binding, ::REManagedObject* obj, const Arg& arg) {
+        if (binding == nullptr || binding->function == nullptr) {
+            return std::nullopt;
         }
 
-        return nullptr;
+        ParamWrapper params{ obj };
+        params.params.in_data = (void***)&arg;
+
+        binding->function(&params.params, sdk::get_thread_context());
+
+        return params;
     }
 }
\ No newline at end of file
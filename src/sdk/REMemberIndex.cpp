@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <memory>
+
+#include <spdlog/spdlog.h>
+
+#include "utility/CoalescingWorker.hpp"
+#include "utility/String.hpp"
+
+#include "ReClass.hpp"
+#include "REMemberIndex.hpp"
+
+namespace sdk {
+    REMemberIndex::REMemberIndex(const std::vector<REType*>& types) {
+        // Parents aren't guaranteed to be in the list, pull them in too, contains() promises the whole chain.
+        std::vector<REType*> pending{ types.begin(), types.end() };
+
+        while (!pending.empty()) {
+            auto t = pending.back();
+            pending.pop_back();
+
+            if (t == nullptr || !m_types.insert(t)) {
+                continue;
+            }
+
+            if (t->super != nullptr) {
+                pending.push_back(t->super);
+            }
+
+            auto to_view = [](const char* s) {
+                return s != nullptr ? std::string_view{ s } : std::string_view{};
+            };
+
+            // Fields
+            if (auto vars = utility::re_managed_object::get_variables(t); vars != nullptr && vars->data != nullptr) {
+                for (auto i = 0; i < vars->num; ++i) {
+                    auto var = vars->data->descriptors[i];
+
+                    if (var == nullptr || var->name == nullptr) {
+                        continue;
+                    }
+
+                    m_members.push_back(Member{ var->name, t, Kind::FIELD, var, nullptr, to_view(var->typeName), 0, 0 });
+                }
+            }
+
+            // Methods
+            auto fields = t->fields;
+
+            if (fields == nullptr || fields->methods == nullptr) {
+                continue;
+            }
+
+            auto methods = fields->methods;
+
+            for (auto i = 0; i < fields->num; ++i) {
+                auto top = (*methods)[i];
+
+                if (top == nullptr || *top == nullptr) {
+                    continue;
+                }
+
+                auto descriptor = (*top)->descriptor;
+
+                if (descriptor == nullptr || descriptor->name == nullptr) {
+                    continue;
+                }
+
+                Member member{ descriptor->name, t, Kind::METHOD, nullptr, descriptor, to_view(descriptor->returnTypeName), (uint32_t)m_params.size(), 0 };
+
+                if (descriptor->params != nullptr) {
+                    for (auto j = 0; j < descriptor->numParams && j < 256; ++j) {
+                        auto& param = (*descriptor->params)[j];
+
+                        m_params.push_back(Param{ to_view(param.paramName), to_view(param.typeName), param.paramTypeFlag & 0x1F });
+                        ++member.num_params;
+                    }
+                }
+
+                m_members.push_back(member);
+            }
+        }
+
+        // Stable, so overloads keep their declaration order and the first one wins like get_method_desc
+        std::stable_sort(m_members.begin(), m_members.end(), [](const Member& a, const Member& b) {
+            return a.name < b.name;
+        });
+
+        for (uint32_t i = 0; i < m_members.size(); ++i) {
+            auto& member = m_members[i];
+
+            if (i == 0 || m_members[i - 1].name != member.name) {
+                m_by_name[member.name] = { i, i };
+            }
+
+            ++m_by_name[member.name].end;
+
+            m_declared.try_emplace(DeclKey{ member.type, utility::hash(member.name), member.kind }, i);
+        }
+    }
+
+    utility::ArrayView<const REMemberIndex::Member> REMemberIndex::find(std::string_view name) const {
+        auto it = m_by_name.find(name);
+
+        if (it == m_by_name.end()) {
+            return {};
+        }
+
+        return { m_members.data() + it->second.begin, it->second.end - it->second.begin };
+    }
+
+    utility::ArrayView<const REMemberIndex::Member> REMemberIndex::find_prefix(std::string_view prefix) const {
+        auto first = std::lower_bound(m_members.begin(), m_members.end(), prefix, [](const Member& m, std::string_view p) {
+            return m.name < p;
+        });
+
+        auto last = first;
+
+        while (last != m_members.end() && last->name.substr(0, prefix.size()) == prefix) {
+            ++last;
+        }
+
+        return { m_members.data() + (first - m_members.begin()), (size_t)(last - first) };
+    }
+
+    const REMemberIndex::Member* REMemberIndex::find_field(REType* t, std::string_view name) const {
+        const auto name_hash = utility::hash(name);
+
+        for (; t != nullptr; t = t->super) {
+            if (auto member = find_declared(t, name, name_hash, Kind::FIELD)) {
+                return member;
+            }
+        }
+
+        return nullptr;
+    }
+
+    const REMemberIndex::Member* REMemberIndex::find_method(REType* t, std::string_view name) const {
+        const auto name_hash = utility::hash(name);
+
+        for (; t != nullptr; t = t->super) {
+            if (auto member = find_declared(t, name, name_hash, Kind::METHOD)) {
+                return member;
+            }
+        }
+
+        return nullptr;
+    }
+
+    utility::ArrayView<const REMemberIndex::Param> REMemberIndex::get_params(const Member& member) const {
+        if (member.num_params == 0) {
+            return {};
+        }
+
+        return { m_params.data() + member.first_param, member.num_params };
+    }
+
+    const REMemberIndex::Member* REMemberIndex::find_declared(REType* t, std::string_view name, size_t name_hash, Kind kind) const {
+        auto it = m_declared.find(DeclKey{ t, name_hash, kind });
+
+        if (it == m_declared.end()) {
+            return nullptr;
+        }
+
+        auto& member = m_members[it->second];
+
+        if (member.name == name) {
+            return &member;
+        }
+
+        // Hash collision within the same type, look through everything with this name instead
+        for (auto& candidate : find(name)) {
+            if (candidate.type == t && candidate.kind == kind) {
+                return &candidate;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static std::shared_ptr<const REMemberIndex> g_member_index{};
+
+    // One build at a time. Types posted while one runs get built right after it, only the latest list.
+    static utility::CoalescingWorker<std::vector<REType*>> g_member_index_builder{ [](std::vector<REType*> types) {
+        auto index = std::make_shared<const REMemberIndex>(types);
+
+        spdlog::info("Member index rebuilt with {} members", index->get_members().size());
+
+        // Builds finish in the order they were posted, so this never replaces a newer one
+        std::atomic_store(&g_member_index, std::move(index));
+    } };
+
+    void rebuild_member_index(std::vector<REType*> types) {
+        g_member_index_builder.post(std::move(types));
+    }
+
+    std::shared_ptr<const REMemberIndex> get_member_index() {
+        return std::atomic_load(&g_member_index);
+    }
+}
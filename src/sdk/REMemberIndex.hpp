@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "utility/ArrayView.hpp"
+#include "utility/FlatMap.hpp"
+
+class REType;
+class VariableDescriptor;
+class FunctionDescriptor;
+
+namespace sdk {
+    // Every field and method declared by every type, by name.
+    // Answers "which types have a field named X" without expanding types by hand, and lets
+    // get_field_desc/get_method_desc skip the linear scan over each type's members.
+    // Snapshots are immutable, a new one gets built on a worker thread when the type list grows.
+    class REMemberIndex {
+    public:
+        enum class Kind : uint8_t {
+            FIELD,
+            METHOD,
+        };
+
+        struct Param {
+            std::string_view name;
+            std::string_view type_name;
+            uint32_t type_kind; // via::reflection::TypeKind
+        };
+
+        struct Member {
+            std::string_view name;
+            REType* type; // the type that declares it
+            Kind kind;
+            VariableDescriptor* field;
+            FunctionDescriptor* method;
+            std::string_view type_name; // field type or method return type
+            uint32_t first_param;
+            uint32_t num_params;
+        };
+
+        REMemberIndex(const std::vector<REType*>& types);
+
+        // Members named exactly name. Only the declaring types, not everything that inherits them.
+        utility::ArrayView<const Member> find(std::string_view name) const;
+        // Members whose name starts with prefix, sorted by name.
+        utility::ArrayView<const Member> find_prefix(std::string_view prefix) const;
+
+        // Walks t and its parents like get_field_desc/get_method_desc.
+        // Only meaningful if contains(t), otherwise nullptr doesn't mean it isn't there.
+        const Member* find_field(REType* t, std::string_view name) const;
+        const Member* find_method(REType* t, std::string_view name) const;
+
+        utility::ArrayView<const Param> get_params(const Member& member) const;
+
+        // Whether t (and so its parents) went into this snapshot
+        bool contains(REType* t) const {
+            return m_types.count(t) > 0;
+        }
+
+        const std::vector<Member>& get_members() const {
+            return m_members;
+        }
+
+        // Every type that went into the snapshot, parents included
+        const utility::FlatSet<REType*>& get_types() const {
+            return m_types;
+        }
+
+    private:
+        struct Range {
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        // (declaring type, FNV-1a of the name) -> member
+        struct DeclKey {
+            REType* type;
+            size_t name_hash;
+            Kind kind;
+
+            bool operator==(const DeclKey& other) const {
+                return type == other.type && name_hash == other.name_hash && kind == other.kind;
+            }
+        };
+
+        struct DeclKeyHasher {
+            size_t operator()(const DeclKey& key) const {
+                return key.name_hash ^ ((uintptr_t)key.type * (size_t)0x9E3779B97F4A7C15) ^ (size_t)key.kind;
+            }
+        };
+
+        const Member* find_declared(REType* t, std::string_view name, size_t name_hash, Kind kind) const;
+
+        // Sorted by name, so exact and prefix queries are both a contiguous run
+        std::vector<Member> m_members;
+        std::vector<Param> m_params;
+
+        utility::FlatMap<std::string_view, Range> m_by_name;
+        utility::FlatMap<DeclKey, uint32_t, DeclKeyHasher> m_declared;
+        utility::FlatSet<REType*> m_types;
+    };
+
+    // Build a new snapshot on a worker thread and publish it when done.
+    // Only one build runs at a time, requests made during it collapse into one more build of the latest types.
+    void rebuild_member_index(std::vector<REType*> types);
+    // null until the first build finishes
+    std::shared_ptr<const REMemberIndex> get_member_index();
+}
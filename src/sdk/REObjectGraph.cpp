@@ -0,0 +1,95 @@
+#include <chrono>
+
+#include <spdlog/spdlog.h>
+
+#include "REObjectGraph.hpp"
+
+namespace sdk {
+    REHeapAdapter::REHeapAdapter(const REMemberIndex& index) {
+        const auto offsets = utility::re_managed_object::get_field_offsets();
+
+        // Instance fields holding a reference, by the type that declares them
+        utility::FlatMap<REType*, std::vector<Ref>> declared{};
+
+        for (auto& member : index.get_members()) {
+            if (member.kind != REMemberIndex::Kind::FIELD || member.field->staticVariableData != nullptr) {
+                continue;
+            }
+
+            auto kind = (via::reflection::TypeKind)(member.field->flags & 0x1F);
+
+            if (kind != via::reflection::TypeKind::Class && kind != via::reflection::TypeKind::String) {
+                continue;
+            }
+
+            auto offset = offsets.find(member.field);
+
+            if (offset == offsets.end() || offset->second <= 0 || offset->second + sizeof(void*) > member.type->size) {
+                continue;
+            }
+
+            declared[member.type].push_back(Ref{ offset->second, member.field });
+        }
+
+        index.get_types().for_each([&](REType* t) {
+            std::vector<Ref> refs{};
+
+            for (auto parent = t; parent != nullptr; parent = parent->super) {
+                if (auto it = declared.find(parent); it != declared.end()) {
+                    refs.insert(refs.end(), it->second.begin(), it->second.end());
+                }
+            }
+
+            if (!refs.empty()) {
+                m_refs[t] = std::move(refs);
+            }
+        });
+    }
+
+    std::unique_ptr<REObjectGraph> walk_object_graph(const REGlobals::SingletonList& singletons) {
+        auto index = get_member_index();
+
+        if (index == nullptr) {
+            return nullptr;
+        }
+
+        std::vector<::REManagedObject*> roots{};
+
+        for (auto& singleton : singletons) {
+            roots.push_back(singleton.obj);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        auto graph = std::make_unique<REObjectGraph>(REHeapAdapter{ *index });
+        graph->walk(roots);
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        auto& total = graph->get_total_stats();
+
+        spdlog::info("Walked {} objects ({} bytes) from {} singletons in {}ms", total.count, total.size, roots.size(), elapsed.count());
+
+        return graph;
+    }
+
+    std::string describe_path(const REObjectGraph& graph, ::REManagedObject* obj) {
+        std::string result{};
+
+        for (auto& step : graph.get_path(obj)) {
+            if (result.empty()) {
+                // The root may not be around anymore
+                auto t = utility::re_managed_object::safe_get_type(step.node);
+                result = t != nullptr && t->name != nullptr ? t->name : "?";
+            }
+            else if (step.edge.field != nullptr) {
+                result += '.';
+                result += step.edge.field->name != nullptr ? step.edge.field->name : "?";
+            }
+            else {
+                result += '[' + std::to_string(step.edge.index) + ']';
+            }
+        }
+
+        return result;
+    }
+}
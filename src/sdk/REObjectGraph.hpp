@@ -0,0 +1,82 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utility/FlatMap.hpp"
+#include "utility/GraphWalker.hpp"
+
+#include "ReClass.hpp"
+
+namespace sdk {
+    // The managed heap as utility::GraphWalker sees it.
+    // References are object/string fields whose offset is known (see re_managed_object::get_field_offsets)
+    // and the elements of object arrays. Fields nobody has discovered an offset for yet aren't followed.
+    class REHeapAdapter {
+    public:
+        using Node = ::REManagedObject*;
+        using Type = ::REType*;
+
+        struct Edge {
+            VariableDescriptor* field; // nullptr for an array element
+            int32_t index;
+        };
+
+        REHeapAdapter(const REMemberIndex& index);
+
+        Type get_type(Node obj) const {
+            return utility::re_managed_object::get_type(obj);
+        }
+
+        size_t get_size(Node obj) const {
+            return utility::re_managed_object::get_size(obj);
+        }
+
+        template <typename F>
+        void for_each_ref(Node obj, F&& func) const {
+            if (utility::re_managed_object::get_vm_type(obj) == via::clr::VMObjType::Array) {
+                auto elements = utility::re_array::get_ptr_view<::REManagedObject>((::REArrayBase*)obj);
+
+                for (size_t i = 0; i < elements.size(); ++i) {
+                    if (utility::re_managed_object::is_managed_object(elements[i])) {
+                        func(elements[i], Edge{ nullptr, (int32_t)i });
+                    }
+                }
+
+                return;
+            }
+
+            auto refs = m_refs.find(get_type(obj));
+
+            if (refs == m_refs.end()) {
+                return;
+            }
+
+            for (auto& ref : refs->second) {
+                auto target = *Address{ obj }.get(ref.offset).as<::REManagedObject**>();
+
+                if (utility::re_managed_object::is_managed_object(target)) {
+                    func(target, Edge{ ref.field, -1 });
+                }
+            }
+        }
+
+    private:
+        struct Ref {
+            int32_t offset;
+            VariableDescriptor* field;
+        };
+
+        // Per type, inherited fields included
+        utility::FlatMap<REType*, std::vector<Ref>> m_refs;
+    };
+
+    using REObjectGraph = utility::GraphWalker<REHeapAdapter>;
+
+    // Walk everything reachable from the singletons, blocks until done. null if the member index isn't built yet.
+    std::unique_ptr<REObjectGraph> walk_object_graph(const REGlobals::SingletonList& singletons);
+
+    // "app.Foo.bar[3].baz", how the walk got to obj
+    std::string describe_path(const REObjectGraph& graph, ::REManagedObject* obj);
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+
+#include "REObjectSnapshot.hpp"
+
+namespace sdk {
+    void REObjectSnapshot::capture(const std::vector<::REManagedObject*>& objects) {
+        m_blocks.clear();
+        m_types.clear();
+
+        for (auto obj : objects) {
+            auto t = utility::re_managed_object::safe_get_type(obj);
+
+            if (t == nullptr) {
+                continue;
+            }
+
+            // The size comes from the object's own length fields, make sure all of it can be read
+            const auto size = std::min(utility::re_managed_object::get_size(obj), MAX_OBJECT_SIZE);
+
+            if (size < sizeof(::REManagedObject) || IsBadReadPtr(obj, size)) {
+                continue;
+            }
+
+            m_blocks.add(obj, size);
+            m_types.push_back(t);
+        }
+    }
+
+    std::vector<REObjectSnapshot::FieldChange> REObjectSnapshot::diff(const REObjectSnapshot& before) const {
+        std::vector<FieldChange> result{};
+
+        const auto changes = m_blocks.diff(before.m_blocks);
+
+        if (changes.empty()) {
+            return result;
+        }
+
+        const auto offsets = utility::re_managed_object::get_field_offsets();
+
+        // Fields with a known offset per type, parents included, sorted by offset. Only for types that changed.
+        utility::FlatMap<REType*, std::vector<std::pair<int32_t, VariableDescriptor*>>> layouts{};
+
+        auto get_layout = [&](REType* t) -> const std::vector<std::pair<int32_t, VariableDescriptor*>>& {
+            auto [it, inserted] = layouts.try_emplace(t);
+            auto& layout = it->second;
+
+            if (!inserted) {
+                return layout;
+            }
+
+            for (auto parent = t; parent != nullptr; parent = parent->super) {
+                auto vars = utility::re_managed_object::get_variables(parent);
+
+                if (vars == nullptr || vars->data == nullptr) {
+                    continue;
+                }
+
+                for (auto i = 0; i < vars->num; ++i) {
+                    auto var = vars->data->descriptors[i];
+
+                    if (auto offset = offsets.find(var); offset != offsets.end() && offset->second > 0) {
+                        layout.emplace_back(offset->second, var);
+                    }
+                }
+            }
+
+            std::sort(layout.begin(), layout.end());
+            return layout;
+        };
+
+        for (auto& change : changes) {
+            auto end = change.offset + change.size;
+            auto offset = std::max<uint32_t>(change.offset, sizeof(::REManagedObject));
+
+            if (offset >= end) {
+                continue;
+            }
+
+            auto obj = (::REManagedObject*)m_blocks.get_ranges()[change.range].address;
+            auto& layout = get_layout(m_types[change.range]);
+
+            // One entry per field the run touches
+            while (offset < end) {
+                auto next = std::upper_bound(layout.begin(), layout.end(), (int32_t)offset, [](int32_t value, const auto& field) {
+                    return value < field.first;
+                });
+
+                auto field = next != layout.begin() ? std::prev(next)->second : nullptr;
+                auto field_end = next != layout.end() ? std::min<uint32_t>(next->first, end) : end;
+
+                result.push_back({ obj, field, offset, field_end - offset });
+                offset = field_end;
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<::REManagedObject*> find_instances(const REObjectGraph& graph, REType* t) {
+        std::vector<::REManagedObject*> result{};
+
+        // Nodes are from whenever the walk ran, some of them are gone by now
+        graph.for_each_node([&](::REManagedObject* obj) {
+            if (sdk::is_a(utility::re_managed_object::safe_get_type(obj), t)) {
+                result.push_back(obj);
+            }
+        });
+
+        // Address order, so captures of the same set line up
+        std::sort(result.begin(), result.end());
+
+        return result;
+    }
+}
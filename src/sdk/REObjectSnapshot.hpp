@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+#include "utility/BlockSnapshot.hpp"
+
+#include "ReClass.hpp"
+#include "REObjectGraph.hpp"
+
+namespace sdk {
+    // Copies of a set of managed objects, diffed against an earlier capture to find which fields changed.
+    class REObjectSnapshot {
+    public:
+        // Arrays and strings can get big, anything past this isn't captured
+        static constexpr uint32_t MAX_OBJECT_SIZE = 0x10000;
+
+        struct FieldChange {
+            ::REManagedObject* object;
+            VariableDescriptor* field; // nullptr if no field with a known offset covers it
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        // Objects that aren't valid anymore or can't be read in full are skipped
+        void capture(const std::vector<::REManagedObject*>& objects);
+
+        // What changed since before, mapped to the closest field at or below each offset.
+        // Changes inside the object header (refcount and such) are left out.
+        std::vector<FieldChange> diff(const REObjectSnapshot& before) const;
+
+        size_t size() const {
+            return m_blocks.get_ranges().size();
+        }
+
+    private:
+        utility::BlockSnapshot m_blocks{};
+        // Captured objects' types, same order as the ranges
+        std::vector<REType*> m_types{};
+    };
+
+    // Every instance of t (or something derived from it) the walk reached
+    std::vector<::REManagedObject*> find_instances(const REObjectGraph& graph, REType* t);
+}
@@ -0,0 +1,154 @@
+#include <fstream>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
+
+#include "utility/Module.hpp"
+
+#include "REFramework.hpp"
+#include "REOffsetDatabase.hpp"
+
+REOffsetDatabase::REOffsetDatabase(std::string path)
+    : m_path{ std::move(path) }
+{
+}
+
+bool REOffsetDatabase::load() {
+    std::lock_guard _{ m_mutex };
+
+    std::ifstream f{ m_path, std::ios::binary };
+
+    if (!f) {
+        return false;
+    }
+
+    Header header{};
+
+    if (!f.read((char*)&header, sizeof(header)) || header.magic != MAGIC || header.version != VERSION) {
+        spdlog::info("[REOffsetDatabase] {:s} is not a valid offset database", m_path);
+        return false;
+    }
+
+    // Offsets from another build of the game can't be trusted.
+    if (header.game_timestamp != get_game_timestamp()) {
+        spdlog::info("[REOffsetDatabase] {:s} is from a different game build, ignoring it", m_path);
+        return false;
+    }
+
+    std::unordered_multimap<uint32_t, REType*> types_by_crc{};
+
+    for (auto t : g_framework->get_types()->copy_types()) {
+        types_by_crc.emplace(t->typeCRC, t);
+    }
+
+    uint32_t num_loaded = 0;
+    std::string name{};
+
+    for (uint32_t i = 0; i < header.num_entries; ++i) {
+        Entry entry{};
+
+        if (!f.read((char*)&entry, sizeof(entry))) {
+            break;
+        }
+
+        name.resize(entry.name_length);
+
+        if (!f.read(name.data(), entry.name_length)) {
+            break;
+        }
+
+        auto [begin, end] = types_by_crc.equal_range(entry.type_crc);
+
+        for (auto it = begin; it != end; ++it) {
+            auto t = it->second;
+            auto vars = utility::re_managed_object::get_variables(t);
+
+            if (vars == nullptr || entry.offset < (int32_t)sizeof(REManagedObject) || (uint32_t)entry.offset >= t->size) {
+                continue;
+            }
+
+            // Only the fields the type declares itself, that's what the entry was saved against.
+            for (auto k = 0; k < vars->num; ++k) {
+                auto desc = vars->data->descriptors[k];
+
+                if (desc == nullptr || desc->name == nullptr || name != desc->name) {
+                    continue;
+                }
+
+                // Only verified offsets get saved, bindings still check them again before using them
+                utility::re_managed_object::set_field_offset(desc, entry.offset, true);
+                ++num_loaded;
+                break;
+            }
+        }
+    }
+
+    spdlog::info("[REOffsetDatabase] Loaded {}/{} offsets from {:s}", num_loaded, header.num_entries, m_path);
+
+    return true;
+}
+
+bool REOffsetDatabase::save() {
+    std::lock_guard _{ m_mutex };
+
+    // Unverified offsets could be wrong, they'd come back every session if we saved them
+    const auto offsets = utility::re_managed_object::get_verified_field_offsets();
+
+    if (offsets.empty()) {
+        return true;
+    }
+
+    std::ofstream f{ m_path, std::ios::binary | std::ios::trunc };
+
+    if (!f) {
+        spdlog::error("[REOffsetDatabase] Failed to open {:s}", m_path);
+        return false;
+    }
+
+    Header header{ MAGIC, VERSION, get_game_timestamp(), 0 };
+
+    // Patched at the end.
+    f.write((const char*)&header, sizeof(header));
+
+    // Descriptors don't know which type declared them, so go through the types.
+    for (auto t : g_framework->get_types()->copy_types()) {
+        auto vars = utility::re_managed_object::get_variables(t);
+
+        if (vars == nullptr) {
+            continue;
+        }
+
+        for (auto i = 0; i < vars->num; ++i) {
+            auto desc = vars->data->descriptors[i];
+
+            if (desc == nullptr || desc->name == nullptr) {
+                continue;
+            }
+
+            auto it = offsets.find(desc);
+
+            if (it == offsets.end()) {
+                continue;
+            }
+
+            const auto name = std::string_view{ desc->name };
+            const Entry entry{ t->typeCRC, it->second, (uint16_t)name.length() };
+
+            f.write((const char*)&entry, sizeof(entry));
+            f.write(name.data(), entry.name_length);
+
+            ++header.num_entries;
+        }
+    }
+
+    f.seekp(0);
+    f.write((const char*)&header, sizeof(header));
+
+    spdlog::info("[REOffsetDatabase] Saved {} offsets to {:s}", header.num_entries, m_path);
+
+    return f.good();
+}
+
+uint32_t REOffsetDatabase::get_game_timestamp() const {
+    return utility::get_module_timestamp(g_framework->get_module().as<HMODULE>()).value_or(0);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <mutex>
+
+#include "ReClass.hpp"
+
+// Field offsets discovered at runtime, saved to disk so discovery only has to run once per game build.
+// Entries are keyed by the declaring type's typeCRC and the field name.
+class REOffsetDatabase {
+public:
+    REOffsetDatabase(std::string path);
+    virtual ~REOffsetDatabase() {};
+
+    // Validates every entry against the current types and hands the good ones to re_managed_object.
+    bool load();
+    // Writes out everything re_managed_object currently knows.
+    bool save();
+
+    const auto& get_path() const {
+        return m_path;
+    }
+
+private:
+    static constexpr uint32_t MAGIC = 0x4F464552; // "REFO"
+    static constexpr uint32_t VERSION = 1;
+
+#pragma pack(push, 1)
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t game_timestamp;
+        uint32_t num_entries;
+    };
+
+    // Followed by name_length bytes of the field name.
+    struct Entry {
+        uint32_t type_crc;
+        int32_t offset;
+        uint16_t name_length;
+    };
+#pragma pack(pop)
+
+    uint32_t get_game_timestamp() const;
+
+    std::string m_path;
+    std::mutex m_mutex{};
+};
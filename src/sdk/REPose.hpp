@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+#include "utility/MatrixKernels.hpp"
+
+#include "ReClass.hpp"
+
+// Operations on whole sets of joint matrices at once.
+// The math itself is in utility/MatrixKernels.hpp, this is the joint array side of it.
+namespace utility::re_pose {
+    // A contiguous run of joints in the joint array
+    struct JointRange {
+        int32_t start{ 0 };
+        int32_t count{ 0 };
+
+        bool empty() const {
+            return count <= 0;
+        }
+    };
+
+    namespace detail {
+        static float* as_floats(Matrix4x4f* m) {
+            return (float*)m;
+        }
+
+        static const float* as_floats(const Matrix4x4f* m) {
+            return (const float*)m;
+        }
+    }
+
+    // Multiply the rotation/scale part (first 3 columns) of each matrix by s, leaving the translation alone.
+    // s = 0 collapses the joints in place, which is how meshes get hidden.
+    static void scale(Matrix4x4f* mats, int32_t count, float s) {
+        matrix_kernels::scale(detail::as_floats(mats), count, s);
+    }
+
+    static void copy(Matrix4x4f* dst, const Matrix4x4f* src, int32_t count) {
+        matrix_kernels::copy(detail::as_floats(dst), detail::as_floats(src), count);
+    }
+
+    // dst = a + (b - a) * t, per element. dst may alias a or b.
+    static void blend(Matrix4x4f* dst, const Matrix4x4f* a, const Matrix4x4f* b, int32_t count, float t) {
+        matrix_kernels::blend(detail::as_floats(dst), detail::as_floats(a), detail::as_floats(b), count, t);
+    }
+
+    // mats[i] = root * mats[i]
+    static void multiply(Matrix4x4f* mats, int32_t count, const Matrix4x4f& root) {
+        matrix_kernels::multiply(detail::as_floats(mats), count, detail::as_floats(&root));
+    }
+
+    //
+    // Joint array helpers
+    //
+
+    // Clamp a range to what the joint array actually holds.
+    // Matrices are stored by jointNumber and ranges are in joint array indices, so the range also
+    // stops at the first joint where the two differ (the engine keeps them equal).
+    static JointRange clamp(const ::RETransform& transform, JointRange range) {
+        auto& joints = transform.joints;
+
+        if (joints.data == nullptr || joints.matrices == nullptr || joints.size <= 0 || range.start < 0 || range.start >= joints.size) {
+            return {};
+        }
+
+        range.count = std::min(range.count, joints.size - range.start);
+
+        for (int32_t i = 0; i < range.count; ++i) {
+            if (!utility::re_transform::is_joint_number(joints.data->joints[range.start + i], range.start + i)) {
+                range.count = i;
+                break;
+            }
+        }
+
+        return range;
+    }
+
+    static Matrix4x4f* get_matrices(const ::RETransform& transform, JointRange range) {
+        return &transform.joints.matrices->data[range.start].worldMatrix;
+    }
+
+    // The joint and everything below it. Assumes children come after their parent in the array,
+    // which is how the engine lays them out, and stops at the first joint outside of the subtree.
+    // parentJoint is a jointNumber, it's only compared against array indices where the two are the same.
+    static JointRange get_subtree(const ::RETransform& transform, int32_t root) {
+        auto joints = utility::re_transform::get_joints(transform);
+        const auto num_joints = (int32_t)joints.size();
+
+        if (root < 0 || root >= num_joints || !utility::re_transform::is_joint_number(joints[root], root)) {
+            return {};
+        }
+
+        auto end = root + 1;
+
+        for (; end < num_joints; ++end) {
+            auto joint = joints[end];
+
+            if (!utility::re_transform::is_joint_number(joint, end)) {
+                break;
+            }
+
+            auto parent = (int32_t)joint->info->parentJoint;
+
+            // Parent has to be somewhere between the root and us
+            if (parent < root || parent >= end) {
+                break;
+            }
+        }
+
+        return { root, end - root };
+    }
+
+    static void scale(const ::RETransform& transform, JointRange range, float s) {
+        if (range = clamp(transform, range); !range.empty()) {
+            scale(get_matrices(transform, range), range.count, s);
+        }
+    }
+
+    static void multiply(const ::RETransform& transform, JointRange range, const Matrix4x4f& root) {
+        if (range = clamp(transform, range); !range.empty()) {
+            multiply(get_matrices(transform, range), range.count, root);
+        }
+    }
+
+    // Save a range of the pose into out (which must hold range.count matrices)
+    static void copy_to(const ::RETransform& transform, JointRange range, Matrix4x4f* out) {
+        if (range = clamp(transform, range); !range.empty()) {
+            copy(out, get_matrices(transform, range), range.count);
+        }
+    }
+
+    static void copy_from(const ::RETransform& transform, JointRange range, const Matrix4x4f* in) {
+        if (range = clamp(transform, range); !range.empty()) {
+            copy(get_matrices(transform, range), in, range.count);
+        }
+    }
+
+    // Blend the current pose of the range towards target by t
+    static void blend(const ::RETransform& transform, JointRange range, const Matrix4x4f* target, float t) {
+        if (range = clamp(transform, range); !range.empty()) {
+            auto mats = get_matrices(transform, range);
+            blend(mats, mats, target, range.count, t);
+        }
+    }
+}
@@ -40,6 +40,12 @@ namespace utility::re_string {
         return utility::narrow(get_view(str));
     }
 
+    // Converted once and cached, for strings that are looked at every frame.
+    // The view stays valid even after the REString is gone.
+    static std::string_view get_interned(const ::REString& str) {
+        return utility::narrow_interned(get_view(str));
+    }
+
     static bool equals(const ::REString& str, std::wstring_view view) {
         return get_view(str) == view;
     }
@@ -1,37 +1,211 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "utility/ArrayView.hpp"
+#include "utility/String.hpp"
+
 #include "Math.hpp"
 
 namespace utility::re_transform {
     static Matrix4x4f invalid_matrix{};
 
-    // Get a bone/joint by name
-    static REJoint* get_joint(const ::RETransform& transform, std::wstring_view name) {
+    // The joints of a transform and their matrices, validated once.
+    struct JointView {
+        ArrayView<::REJoint*> joints{};
+        ::JointMatrices* matrices{ nullptr };
+
+        auto begin() const { return joints.begin(); }
+        auto end() const { return joints.end(); }
+        size_t size() const { return joints.size(); }
+        bool empty() const { return joints.empty(); }
+
+        ::REJoint* operator[](size_t i) const {
+            return joints[i];
+        }
+
+        // Matrix for the joint at index i of the joint array
+        Matrix4x4f& get_matrix(size_t i) const {
+            return matrices->data[i].worldMatrix;
+        }
+
+        ArrayView<Matrix4x4f> get_matrices() const {
+            return { &matrices->data[0].worldMatrix, joints.size() };
+        }
+    };
+
+    // Joints are looked up by their index in the joint array, their matrices by info->jointNumber.
+    // The engine keeps the two equal, anything that uses one for the other checks it with this.
+    static bool is_joint_number(const ::REJoint* joint, int32_t i) {
+        return joint != nullptr && joint->info != nullptr && joint->info->jointNumber == i;
+    }
+
+    static JointView get_joints(const ::RETransform& transform) {
         auto& joint_array = transform.joints;
 
         if (joint_array.size <= 0 || joint_array.numAllocated <= 0 || joint_array.data == nullptr || joint_array.matrices == nullptr) {
-            return nullptr;
+            return {};
         }
 
-        for (int32_t i = 0; i < joint_array.size; ++i) {
+        return { { joint_array.data->joints, (size_t)joint_array.size }, joint_array.matrices };
+    }
+
+    namespace detail {
+        // Joint name hash -> index into the joint array, one per skeleton.
+        struct JointIndex {
+            int32_t size{ 0 };
+            uint32_t built_frame{ 0 };
+            std::atomic<uint32_t> used_frame{ 0 };
+            std::unordered_map<size_t, int32_t> joints{};
+        };
+
+        inline std::shared_mutex g_joint_index_mutex{};
+        inline std::unordered_map<const void*, std::unique_ptr<JointIndex>> g_joint_indices{};
+        // Size at which the next sweep for skeletons nobody uses anymore happens
+        inline size_t g_joint_index_limit{ 0x400 };
+
+        static bool is_joint_array_valid(const ::REJointArray& joint_array) {
+            return joint_array.size > 0 && joint_array.numAllocated > 0 && joint_array.data != nullptr && joint_array.matrices != nullptr;
+        }
+
+        static REJoint* get_joint_at(const ::REJointArray& joint_array, int32_t i, std::wstring_view name) {
+            if (i < 0 || i >= joint_array.size) {
+                return nullptr;
+            }
+
             auto joint = joint_array.data->joints[i];
 
-            if (joint == nullptr) {
-                continue;
+            if (joint == nullptr || joint->info == nullptr || joint->info->name == nullptr || name != joint->info->name) {
+                return nullptr;
             }
 
-            auto joint_info = joint->info;
+            return joint;
+        }
+
+        static void build_joint_index(JointIndex& index, const JointView& joints, uint32_t frame) {
+            index.size = (int32_t)joints.size();
+            index.built_frame = frame;
+            index.joints.clear();
+            index.joints.reserve(joints.size());
 
-            if (joint_info == nullptr || joint_info->name == nullptr) {
-                continue;
+            for (int32_t i = 0; i < index.size; ++i) {
+                auto joint = joints[i];
+
+                // A joint whose number isn't its index is only found by the scan
+                if (!is_joint_number(joint, i) || joint->info->name == nullptr) {
+                    continue;
+                }
+
+                // First one wins, same as the linear scan
+                index.joints.emplace(utility::hash(std::wstring_view{ joint->info->name }), i);
+            }
+        }
+
+        // Must be called with the unique lock held
+        static JointIndex& get_joint_index_for(const void* key, uint32_t frame) {
+            auto it = g_joint_indices.find(key);
+
+            if (it != g_joint_indices.end()) {
+                return *it->second;
             }
 
-            if (name == joint_info->name) {
-                return joint;
+            // Skeletons whose transforms are gone stop getting asked about, drop those.
+            // Only when a new one comes in, and the limit grows with whatever survives.
+            if (g_joint_indices.size() >= g_joint_index_limit) {
+                for (auto stale = g_joint_indices.begin(); stale != g_joint_indices.end();) {
+                    if (frame - stale->second->used_frame.load(std::memory_order_relaxed) > 60) {
+                        stale = g_joint_indices.erase(stale);
+                    }
+                    else {
+                        ++stale;
+                    }
+                }
+
+                g_joint_index_limit = std::max<size_t>(0x400, g_joint_indices.size() * 2);
             }
+
+            auto& index = *g_joint_indices.emplace(key, std::make_unique<JointIndex>()).first->second;
+
+            // Not built yet
+            index.size = -1;
+
+            return index;
+        }
+    }
+
+    // Get the index of a bone/joint in the joint array by name, -1 if not found.
+    // For every joint the cache hands back that's also its jointNumber (see is_joint_number).
+    // Cached per skeleton (the joint array data pointer). Hits are checked against the joint's name,
+    // a stale hit or a miss rebuilds the index, at most once a frame per skeleton.
+    static int32_t get_joint_index(const ::RETransform& transform, std::wstring_view name) {
+        auto& joint_array = transform.joints;
+
+        if (!detail::is_joint_array_valid(joint_array)) {
+            return -1;
+        }
+
+        const auto name_hash = utility::hash(name);
+        const auto key = (const void*)joint_array.data;
+        const auto frame = sdk::get_frame_count();
+
+        {
+            std::shared_lock _{ detail::g_joint_index_mutex };
+
+            if (auto it = detail::g_joint_indices.find(key); it != detail::g_joint_indices.end() && it->second->size == joint_array.size) {
+                auto& index = *it->second;
+                index.used_frame.store(frame, std::memory_order_relaxed);
+
+                auto joint_it = index.joints.find(name_hash);
+
+                if (joint_it != index.joints.end() && detail::get_joint_at(joint_array, joint_it->second, name) != nullptr) {
+                    return joint_it->second;
+                }
+
+                // Already rebuilt this frame, a miss is a miss
+                if (joint_it == index.joints.end() && index.built_frame == frame) {
+                    return -1;
+                }
+            }
+        }
+
+        std::unique_lock _{ detail::g_joint_index_mutex };
+        auto& index = detail::get_joint_index_for(key, frame);
+
+        index.used_frame.store(frame, std::memory_order_relaxed);
+
+        if (index.size != joint_array.size || index.built_frame != frame) {
+            detail::build_joint_index(index, get_joints(transform), frame);
+        }
+
+        if (auto joint_it = index.joints.find(name_hash); joint_it != index.joints.end() && detail::get_joint_at(joint_array, joint_it->second, name) != nullptr) {
+            return joint_it->second;
+        }
+
+        // Two names hashing the same, fall back to the scan
+        for (int32_t i = 0; i < joint_array.size; ++i) {
+            if (detail::get_joint_at(joint_array, i, name) != nullptr) {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    // Get a bone/joint by name
+    static REJoint* get_joint(const ::RETransform& transform, std::wstring_view name) {
+        auto i = get_joint_index(transform, name);
+
+        if (i == -1) {
+            return nullptr;
         }
 
-        return nullptr;
+        return transform.joints.data->joints[i];
     }
 
     // Get a bone/joint matrix by name
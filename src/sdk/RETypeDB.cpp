@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
+
+#include "utility/Module.hpp"
+
+#include "REFramework.hpp"
+#include "RETypeDB.hpp"
+
+namespace sdk {
+    static void write_type_db(const REMemberIndex& index, const REEnumCatalog& catalog, uint32_t game_timestamp, const std::string& path) {
+        typedb::Writer db{};
+
+        auto to_view = [](const char* s) {
+            return s != nullptr ? std::string_view{ s } : std::string_view{};
+        };
+
+        // Types, sorted by name so two exports of the same build come out the same
+        std::vector<REType*> types{};
+        types.reserve(index.get_types().size());
+        index.get_types().for_each([&](REType* t) { types.push_back(t); });
+
+        std::sort(types.begin(), types.end(), [&](REType* a, REType* b) {
+            return to_view(a->name) < to_view(b->name);
+        });
+
+        std::unordered_map<REType*, uint32_t> type_indices{};
+        type_indices.reserve(types.size());
+
+        for (uint32_t i = 0; i < types.size(); ++i) {
+            type_indices[types[i]] = i;
+        }
+
+        std::vector<std::vector<uint32_t>> children(types.size());
+        std::vector<uint32_t> roots{};
+
+        for (uint32_t i = 0; i < types.size(); ++i) {
+            auto t = types[i];
+            auto super = t->super != nullptr ? type_indices.find(t->super) : type_indices.end();
+
+            db.types.push_back(typedb::Type{ db.add_string(to_view(t->name)), typedb::NONE, t->size, t->typeCRC });
+
+            if (super != type_indices.end()) {
+                db.types.back().super = super->second;
+                children[super->second].push_back(i);
+            }
+            else {
+                roots.push_back(i);
+            }
+        }
+
+        // Pre/post numbering, same scheme as RETypeHierarchy
+        uint32_t counter = 0;
+
+        for (auto root : roots) {
+            std::vector<std::pair<uint32_t, uint32_t>> stack{ { root, 0 } };
+            db.types[root].pre = counter++;
+
+            while (!stack.empty()) {
+                auto& [i, next_child] = stack.back();
+
+                if (next_child < children[i].size()) {
+                    const auto child = children[i][next_child++];
+
+                    db.types[child].pre = counter++;
+                    stack.emplace_back(child, 0);
+                }
+                else {
+                    db.types[i].post = counter++;
+                    stack.pop_back();
+                }
+            }
+        }
+
+        // Members, grouped by declaring type. The index is sorted by name so each group is too.
+        std::vector<std::vector<const REMemberIndex::Member*>> fields_of(types.size());
+        std::vector<std::vector<const REMemberIndex::Member*>> methods_of(types.size());
+
+        for (auto& member : index.get_members()) {
+            auto it = type_indices.find(member.type);
+
+            if (it == type_indices.end()) {
+                continue;
+            }
+
+            (member.kind == REMemberIndex::Kind::FIELD ? fields_of : methods_of)[it->second].push_back(&member);
+        }
+
+        const auto offsets = utility::re_managed_object::get_field_offsets();
+
+        for (uint32_t i = 0; i < types.size(); ++i) {
+            auto& t = db.types[i];
+
+            t.first_field = (uint32_t)db.fields.size();
+            t.num_fields = (uint32_t)fields_of[i].size();
+
+            for (auto member : fields_of[i]) {
+                auto offset = offsets.find(member->field);
+
+                db.fields.push_back(typedb::Field{
+                    db.add_string(member->name),
+                    db.add_string(member->type_name),
+                    i,
+                    (uint32_t)member->field->flags,
+                    offset != offsets.end() ? offset->second : -1
+                });
+            }
+
+            t.first_method = (uint32_t)db.methods.size();
+            t.num_methods = (uint32_t)methods_of[i].size();
+
+            for (auto member : methods_of[i]) {
+                db.methods.push_back(typedb::Method{ db.add_string(member->name), db.add_string(member->type_name), i, (uint32_t)db.params.size(), 0 });
+
+                for (auto& param : index.get_params(*member)) {
+                    db.params.push_back(typedb::Param{ db.add_string(param.name), db.add_string(param.type_name), param.type_kind });
+                    ++db.methods.back().num_params;
+                }
+            }
+        }
+
+        // Enums, the catalog keeps the engine's order but the file wants them by name
+        std::vector<const REEnumCatalog::Enum*> enums{};
+
+        for (auto& entry : catalog.get_enums()) {
+            enums.push_back(&entry.value);
+        }
+
+        std::sort(enums.begin(), enums.end(), [](auto a, auto b) {
+            return a->name < b->name;
+        });
+
+        for (auto e : enums) {
+            db.enums.push_back(typedb::Enum{ db.add_string(e->name), (uint32_t)db.enum_values.size(), (uint32_t)e->values.size() });
+
+            for (auto& v : e->values) {
+                db.enum_values.push_back(typedb::EnumValue{ v.value, db.add_string(v.name) });
+            }
+        }
+
+        std::ofstream out{ path, std::ios::binary };
+
+        if (!db.write(out, game_timestamp)) {
+            spdlog::error("Failed to write type database to {:s}", path);
+            return;
+        }
+
+        spdlog::info("Exported {} types, {} fields, {} methods and {} enums to {:s}", db.types.size(), db.fields.size(), db.methods.size(), db.enums.size(), path);
+    }
+
+    bool export_type_db(std::string path) {
+        auto index = get_member_index();
+        auto catalog = get_enum_catalog();
+
+        if (index == nullptr || catalog == nullptr) {
+            return false;
+        }
+
+        const auto game_timestamp = utility::get_module_timestamp(g_framework->get_module().as<HMODULE>()).value_or(0);
+
+        std::thread([index, catalog, game_timestamp, path = std::move(path)]() {
+            write_type_db(*index, *catalog, game_timestamp, path);
+        }).detach();
+
+        return true;
+    }
+}
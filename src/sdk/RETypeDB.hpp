@@ -0,0 +1,470 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Binary snapshot of everything the framework knows about the game's types.
+// Written by sdk::export_type_db, read by the framework or by tools/typedb on any platform.
+//
+// Every section is a flat array of the structs below at a fixed offset from the start of the file,
+// so a reader maps the file and casts, there's nothing to parse. Strings live in one table and are
+// referenced by offset + length (they're also null terminated). Only standard headers in here,
+// this file is shared with the offline tools.
+namespace sdk::typedb {
+    static constexpr char MAGIC[8]{ 'R', 'E', 'T', 'Y', 'P', 'E', 'D', 'B' };
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+
+#pragma pack(push, 1)
+    struct Section {
+        uint64_t offset;
+        uint64_t count; // elements, bytes for the string table
+    };
+
+    struct String {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t game_timestamp;
+
+        Section strings;
+        Section types;
+        Section fields;
+        Section methods;
+        Section params;
+        Section enums;
+        Section enum_values;
+        Section type_names; // NameIndex over types, sorted by hash
+        Section field_names; // NameIndex over fields, sorted by hash
+    };
+
+    struct Type {
+        String name;
+        uint32_t super; // index into types, NONE for roots
+        uint32_t size;
+        uint32_t type_crc;
+        // Pre/post numbering of the type tree, a is_a b when b.pre <= a.pre && a.post <= b.post
+        uint32_t pre;
+        uint32_t post;
+        // Members the type declares itself, inherited ones are on the parents
+        uint32_t first_field;
+        uint32_t num_fields;
+        uint32_t first_method;
+        uint32_t num_methods;
+    };
+
+    struct Field {
+        String name;
+        String type_name;
+        uint32_t declaring_type;
+        uint32_t flags; // (flags & 0x1F) = via::reflection::TypeKind
+        int32_t offset; // discovered offset, -1 if unknown
+    };
+
+    struct Method {
+        String name;
+        String return_type;
+        uint32_t declaring_type;
+        uint32_t first_param;
+        uint32_t num_params;
+    };
+
+    struct Param {
+        String name;
+        String type_name;
+        uint32_t type_kind;
+    };
+
+    struct Enum {
+        String name;
+        uint32_t first_value;
+        uint32_t num_values; // sorted by value
+    };
+
+    struct EnumValue {
+        int64_t value;
+        String name;
+    };
+
+    struct NameIndex {
+        uint64_t hash; // FNV-1a of the name
+        uint32_t index;
+    };
+#pragma pack(pop)
+
+    static constexpr uint64_t hash(std::string_view data) {
+        uint64_t result = 0xcbf29ce484222325;
+
+        for (char c : data) {
+            result ^= c;
+            result *= (uint64_t)1099511628211;
+        }
+
+        return result;
+    }
+
+    template <typename T>
+    struct Span {
+        const T* data{ nullptr };
+        uint32_t size{ 0 };
+
+        const T* begin() const { return data; }
+        const T* end() const { return data + size; }
+        const T& operator[](uint32_t i) const { return data[i]; }
+        bool empty() const { return size == 0; }
+    };
+
+    // Read-only view over a snapshot in memory (usually a mapped file).
+    // valid() checks the header and that every section fits, after that nothing is copied or parsed.
+    class View {
+    public:
+        View() = default;
+
+        View(const void* data, size_t size)
+            : m_data{ (const uint8_t*)data },
+            m_size{ size }
+        {
+            m_valid = validate();
+        }
+
+        bool valid() const {
+            return m_valid;
+        }
+
+        const Header& get_header() const {
+            return *(const Header*)m_data;
+        }
+
+        std::string_view get_string(const String& s) const {
+            return { (const char*)m_data + get_header().strings.offset + s.offset, s.length };
+        }
+
+        Span<Type> types() const { return section<Type>(get_header().types); }
+        Span<Field> fields() const { return section<Field>(get_header().fields); }
+        Span<Method> methods() const { return section<Method>(get_header().methods); }
+        Span<Param> params() const { return section<Param>(get_header().params); }
+        Span<Enum> enums() const { return section<Enum>(get_header().enums); }
+        Span<EnumValue> enum_values() const { return section<EnumValue>(get_header().enum_values); }
+
+        Span<Field> fields(const Type& t) const { return { fields().data + t.first_field, t.num_fields }; }
+        Span<Method> methods(const Type& t) const { return { methods().data + t.first_method, t.num_methods }; }
+        Span<Param> params(const Method& m) const { return { params().data + m.first_param, m.num_params }; }
+        Span<EnumValue> values(const Enum& e) const { return { enum_values().data + e.first_value, e.num_values }; }
+
+        const Type* find_type(std::string_view name) const {
+            const Type* result = nullptr;
+
+            for_each_named(section<NameIndex>(get_header().type_names), name, [&](uint32_t i) {
+                if (result == nullptr && get_string(types()[i].name) == name) {
+                    result = &types()[i];
+                }
+            });
+
+            return result;
+        }
+
+        // Calls func(const Field&) for every field named name, across all types
+        template <typename F>
+        void for_each_field_named(std::string_view name, F&& func) const {
+            for_each_named(section<NameIndex>(get_header().field_names), name, [&](uint32_t i) {
+                if (get_string(fields()[i].name) == name) {
+                    func(fields()[i]);
+                }
+            });
+        }
+
+        // Walks t and its parents
+        const Field* find_field(const Type* t, std::string_view name) const {
+            // Bounded in case a broken file has a loop in it
+            for (uint32_t depth = 0; t != nullptr && depth < types().size; t = get_super(*t), ++depth) {
+                for (auto& field : fields(*t)) {
+                    if (get_string(field.name) == name) {
+                        return &field;
+                    }
+                }
+            }
+
+            return nullptr;
+        }
+
+        const Type* get_super(const Type& t) const {
+            return t.super != NONE && t.super < types().size ? &types()[t.super] : nullptr;
+        }
+
+        bool is_a(const Type& t, const Type& base) const {
+            return base.pre <= t.pre && t.post <= base.post;
+        }
+
+        // Enums are sorted by name
+        const Enum* find_enum(std::string_view name) const {
+            auto all = enums();
+            uint32_t lo = 0, hi = all.size;
+
+            while (lo < hi) {
+                const auto mid = lo + (hi - lo) / 2;
+
+                if (get_string(all[mid].name) < name) {
+                    lo = mid + 1;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+
+            return lo < all.size && get_string(all[lo].name) == name ? &all[lo] : nullptr;
+        }
+
+        std::string_view get_enum_value_name(const Enum& e, int64_t value) const {
+            auto all = values(e);
+            uint32_t lo = 0, hi = all.size;
+
+            while (lo < hi) {
+                const auto mid = lo + (hi - lo) / 2;
+
+                if (all[mid].value < value) {
+                    lo = mid + 1;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+
+            return lo < all.size && all[lo].value == value ? get_string(all[lo].name) : std::string_view{};
+        }
+
+    private:
+        template <typename T>
+        Span<T> section(const Section& s) const {
+            return { (const T*)(m_data + s.offset), (uint32_t)s.count };
+        }
+
+        template <typename F>
+        void for_each_named(Span<NameIndex> index, std::string_view name, F&& func) const {
+            const auto h = hash(name);
+            uint32_t lo = 0, hi = index.size;
+
+            while (lo < hi) {
+                const auto mid = lo + (hi - lo) / 2;
+
+                if (index[mid].hash < h) {
+                    lo = mid + 1;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+
+            for (; lo < index.size && index[lo].hash == h; ++lo) {
+                func(index[lo].index);
+            }
+        }
+
+        bool fits(const Section& s, size_t element_size) const {
+            return s.offset <= m_size && s.count <= (m_size - s.offset) / element_size;
+        }
+
+        bool validate() const {
+            if (m_data == nullptr || m_size < sizeof(Header)) {
+                return false;
+            }
+
+            auto& h = get_header();
+
+            if (memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION) {
+                return false;
+            }
+
+            if (!fits(h.strings, 1) || !fits(h.types, sizeof(Type)) || !fits(h.fields, sizeof(Field)) ||
+                !fits(h.methods, sizeof(Method)) || !fits(h.params, sizeof(Param)) || !fits(h.enums, sizeof(Enum)) ||
+                !fits(h.enum_values, sizeof(EnumValue)) || !fits(h.type_names, sizeof(NameIndex)) || !fits(h.field_names, sizeof(NameIndex)))
+            {
+                return false;
+            }
+
+            // Strings and member ranges are trusted from here on, check them once instead of on every access
+            auto check_string = [&](const String& s) {
+                return (uint64_t)s.offset + s.length < h.strings.count;
+            };
+
+            auto check_range = [](uint32_t first, uint32_t count, uint64_t total) {
+                return (uint64_t)first + count <= total;
+            };
+
+            for (auto& t : types()) {
+                if (!check_string(t.name) || !check_range(t.first_field, t.num_fields, h.fields.count) || !check_range(t.first_method, t.num_methods, h.methods.count)) {
+                    return false;
+                }
+            }
+
+            for (auto& f : fields()) {
+                if (!check_string(f.name) || !check_string(f.type_name) || f.declaring_type >= h.types.count) {
+                    return false;
+                }
+            }
+
+            for (auto& m : methods()) {
+                if (!check_string(m.name) || !check_string(m.return_type) || m.declaring_type >= h.types.count ||
+                    !check_range(m.first_param, m.num_params, h.params.count))
+                {
+                    return false;
+                }
+            }
+
+            for (auto& p : params()) {
+                if (!check_string(p.name) || !check_string(p.type_name)) {
+                    return false;
+                }
+            }
+
+            for (auto& e : enums()) {
+                if (!check_string(e.name) || !check_range(e.first_value, e.num_values, h.enum_values.count)) {
+                    return false;
+                }
+            }
+
+            for (auto& v : enum_values()) {
+                if (!check_string(v.name)) {
+                    return false;
+                }
+            }
+
+            for (auto& n : section<NameIndex>(h.type_names)) {
+                if (n.index >= h.types.count) {
+                    return false;
+                }
+            }
+
+            for (auto& n : section<NameIndex>(h.field_names)) {
+                if (n.index >= h.fields.count) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        const uint8_t* m_data{ nullptr };
+        size_t m_size{ 0 };
+        bool m_valid{ false };
+    };
+
+    // Collects the sections in memory and writes them out in one go.
+    // Fill types/fields/methods/params/enums/enum_values with add_string'd names, write() sorts the name indices.
+    class Writer {
+    public:
+        String add_string(std::string_view s) {
+            if (auto it = m_string_offsets.find(std::string{ s }); it != m_string_offsets.end()) {
+                return { it->second, (uint32_t)s.size() };
+            }
+
+            const auto offset = (uint32_t)m_strings.size();
+
+            m_strings.insert(m_strings.end(), s.begin(), s.end());
+            m_strings.push_back('\0');
+            m_string_offsets.emplace(std::string{ s }, offset);
+
+            return { offset, (uint32_t)s.size() };
+        }
+
+        std::string_view get_string(const String& s) const {
+            return { m_strings.data() + s.offset, s.length };
+        }
+
+        bool write(std::ostream& out, uint32_t game_timestamp) const {
+            std::vector<NameIndex> type_names{};
+            std::vector<NameIndex> field_names{};
+
+            for (uint32_t i = 0; i < types.size(); ++i) {
+                type_names.push_back({ hash(get_string(types[i].name)), i });
+            }
+
+            for (uint32_t i = 0; i < fields.size(); ++i) {
+                field_names.push_back({ hash(get_string(fields[i].name)), i });
+            }
+
+            auto by_hash = [](const NameIndex& a, const NameIndex& b) {
+                return a.hash != b.hash ? a.hash < b.hash : a.index < b.index;
+            };
+
+            std::sort(type_names.begin(), type_names.end(), by_hash);
+            std::sort(field_names.begin(), field_names.end(), by_hash);
+
+            Header header{};
+            memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.game_timestamp = game_timestamp;
+
+            // Lay the sections out back to back after the header, 8 byte aligned
+            uint64_t offset = sizeof(Header);
+
+            auto place = [&](Section& section, uint64_t count, size_t element_size) {
+                offset = (offset + 7) & ~(uint64_t)7;
+                section = { offset, count };
+                offset += count * element_size;
+            };
+
+            place(header.strings, m_strings.size(), 1);
+            place(header.types, types.size(), sizeof(Type));
+            place(header.fields, fields.size(), sizeof(Field));
+            place(header.methods, methods.size(), sizeof(Method));
+            place(header.params, params.size(), sizeof(Param));
+            place(header.enums, enums.size(), sizeof(Enum));
+            place(header.enum_values, enum_values.size(), sizeof(EnumValue));
+            place(header.type_names, type_names.size(), sizeof(NameIndex));
+            place(header.field_names, field_names.size(), sizeof(NameIndex));
+
+            uint64_t written = 0;
+
+            auto emit = [&](const Section& section, const void* data, size_t size) {
+                static constexpr char padding[8]{};
+
+                out.write(padding, (std::streamsize)(section.offset - written));
+                out.write((const char*)data, (std::streamsize)size);
+
+                written = section.offset + size;
+            };
+
+            out.write((const char*)&header, sizeof(header));
+            written = sizeof(header);
+
+            emit(header.strings, m_strings.data(), m_strings.size());
+            emit(header.types, types.data(), types.size() * sizeof(Type));
+            emit(header.fields, fields.data(), fields.size() * sizeof(Field));
+            emit(header.methods, methods.data(), methods.size() * sizeof(Method));
+            emit(header.params, params.data(), params.size() * sizeof(Param));
+            emit(header.enums, enums.data(), enums.size() * sizeof(Enum));
+            emit(header.enum_values, enum_values.data(), enum_values.size() * sizeof(EnumValue));
+            emit(header.type_names, type_names.data(), type_names.size() * sizeof(NameIndex));
+            emit(header.field_names, field_names.data(), field_names.size() * sizeof(NameIndex));
+
+            return out.good();
+        }
+
+        std::vector<Type> types{};
+        std::vector<Field> fields{};
+        std::vector<Method> methods{};
+        std::vector<Param> params{};
+        std::vector<Enum> enums{}; // must be sorted by name
+        std::vector<EnumValue> enum_values{};
+
+    private:
+        std::vector<char> m_strings{};
+        std::unordered_map<std::string, uint32_t> m_string_offsets{};
+    };
+}
+
+namespace sdk {
+    // Framework side, in RETypeDB.cpp. Writes the snapshot on a worker thread.
+    // Returns false if the member index or the enum catalog isn't built yet.
+    bool export_type_db(std::string path);
+}
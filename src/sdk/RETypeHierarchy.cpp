@@ -0,0 +1,92 @@
+#include <memory>
+
+#include <spdlog/spdlog.h>
+
+#include "utility/CoalescingWorker.hpp"
+#include "utility/String.hpp"
+
+#include "ReClass.hpp"
+#include "RETypeHierarchy.hpp"
+
+namespace sdk {
+    RETypeHierarchy::RETypeHierarchy(const std::vector<REType*>& types)
+        : m_intervals{ types, [](REType* t) { return t->super; } }
+    {
+        m_names.reserve(m_intervals.size());
+
+        m_intervals.for_each([this](REType* t) {
+            if (t->name != nullptr) {
+                m_names.emplace(utility::hash(t->name), t);
+            }
+        });
+    }
+
+    int32_t RETypeHierarchy::is_a(REType* t, REType* base) const {
+        return m_intervals.is_a(t, base);
+    }
+
+    REType* RETypeHierarchy::find(std::string_view name) const {
+        auto it = m_names.find(utility::hash(name));
+
+        if (it == m_names.end()) {
+            return nullptr;
+        }
+
+        // Hash collision, let the caller go the slow way
+        if (it->second->name == nullptr || name != it->second->name) {
+            return nullptr;
+        }
+
+        return it->second;
+    }
+
+    static std::shared_ptr<const RETypeHierarchy> g_hierarchy{};
+
+    static utility::CoalescingWorker<std::vector<REType*>> g_hierarchy_builder{ [](std::vector<REType*> types) {
+        auto hierarchy = std::make_shared<const RETypeHierarchy>(types);
+
+        spdlog::info("Type hierarchy rebuilt with {} types", hierarchy->size());
+
+        // The previous one goes away with its last reader
+        std::atomic_store(&g_hierarchy, std::move(hierarchy));
+    } };
+
+    void rebuild_type_hierarchy(std::vector<REType*> types) {
+        // Nothing to fall back on for the first one, build it right here
+        g_hierarchy_builder.post(std::move(types), get_type_hierarchy() == nullptr);
+    }
+
+    std::shared_ptr<const RETypeHierarchy> get_type_hierarchy() {
+        return std::atomic_load(&g_hierarchy);
+    }
+
+    bool is_a(REType* t, REType* base) {
+        if (t == nullptr || base == nullptr) {
+            return false;
+        }
+
+        if (auto hierarchy = get_type_hierarchy(); hierarchy != nullptr) {
+            if (auto result = hierarchy->is_a(t, base); result != -1) {
+                return result == 1;
+            }
+        }
+
+        for (; t != nullptr && t->name != nullptr; t = t->super) {
+            if (t == base) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    REType* find_type(std::string_view name) {
+        auto hierarchy = get_type_hierarchy();
+
+        if (hierarchy == nullptr) {
+            return nullptr;
+        }
+
+        return hierarchy->find(name);
+    }
+}
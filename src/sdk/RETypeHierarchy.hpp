@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "utility/TypeIntervals.hpp"
+
+class REType;
+
+namespace sdk {
+    // The type tree numbered by utility::TypeIntervals, so "is A derived from B"
+    // turns into two integer compares instead of a walk up the super chain.
+    // Snapshots are immutable once published, a new one gets built when RETypes' type list grows.
+    class RETypeHierarchy {
+    public:
+        RETypeHierarchy(const std::vector<REType*>& types);
+
+        // Returns 1 if t derives from (or is) base, 0 if not, -1 if either isn't in the table.
+        int32_t is_a(REType* t, REType* base) const;
+
+        REType* find(std::string_view name) const;
+
+        size_t size() const {
+            return m_intervals.size();
+        }
+
+    private:
+        utility::TypeIntervals<REType*> m_intervals;
+        std::unordered_map<size_t, REType*> m_names;
+    };
+
+    // Build a new snapshot from the type list and publish it.
+    // The first one is built before this returns, later ones on a worker thread. Requests that come in
+    // while a build is running are folded into one build of the latest list.
+    // Readers of the previous snapshot are unaffected, it's freed once the last of them lets go.
+    void rebuild_type_hierarchy(std::vector<REType*> types);
+    // null until the first build
+    std::shared_ptr<const RETypeHierarchy> get_type_hierarchy();
+
+    // Subtype check, falls back to walking the super chain for types the table doesn't know yet.
+    bool is_a(REType* t, REType* base);
+    // Name -> type lookup through the hierarchy snapshot, nullptr if not found.
+    REType* find_type(std::string_view name);
+
+    // Handle to a type by name, resolved on first use.
+    // Meant to be kept around as a static or a member, like FieldRef.
+    class RETypeRef {
+    public:
+        constexpr RETypeRef(std::string_view name)
+            : m_name{ name }
+        {
+        }
+
+        REType* get() const {
+            auto t = m_type.load(std::memory_order_acquire);
+
+            if (t != nullptr) {
+                return t;
+            }
+
+            // Not cached until the type actually exists
+            t = find_type(m_name);
+
+            if (t != nullptr) {
+                m_type.store(t, std::memory_order_release);
+            }
+
+            return t;
+        }
+
+        REType* operator()() const {
+            return get();
+        }
+
+        std::string_view get_name() const {
+            return m_name;
+        }
+
+    private:
+        std::string_view m_name;
+        mutable std::atomic<REType*> m_type{ nullptr };
+    };
+}
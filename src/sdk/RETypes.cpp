@@ -26,12 +26,8 @@ RETypes::RETypes() {
     m_raw_types = (TypeList*)(utility::calculate_absolute(*ref + 3));
     spdlog::info("TypeList: {:x}", (uintptr_t)m_raw_types);
 
-    auto& typeList = *m_raw_types;
-
     // I don't know why but it can extend past the size.
-    for (auto i = 0; i < typeList.numAllocated; ++i) {
-        auto t = (*typeList.data)[i];
-
+    for (auto t : get_raw_view()) {
         if (t == nullptr || IsBadReadPtr(t, sizeof(REType)) || ((uintptr_t)t & (sizeof(void*) - 1)) != 0) {
             continue;
         }
@@ -40,7 +36,7 @@ RETypes::RETypes() {
             continue;
         }
 
-        auto name = std::string{ t->name };
+        auto name = std::string_view{ t->name };
 
         if (name.empty()) {
             continue;
@@ -53,6 +49,9 @@ RETypes::RETypes() {
         m_type_list.push_back(t);
     }
 
+    sdk::rebuild_type_hierarchy(m_type_list);
+    sdk::rebuild_member_index(m_type_list);
+
     spdlog::info("Finished RETypes initialization");
 }
 
@@ -60,8 +59,8 @@ REType* RETypes::get(std::string_view name) {
     std::lock_guard _{ m_map_mutex };
 
     auto getObj = [&]() -> REType* {
-        if (auto it = m_type_map.find(name.data()); it != m_type_map.end()) {
-            return it->second;
+        if (auto t = m_type_map.find(name); t != nullptr) {
+            return *t;
         }
 
         return nullptr;
@@ -83,18 +82,44 @@ REType* RETypes::operator[](std::string_view name) {
     return get(name);
 }
 
+REType* RETypes::find(std::string_view name) {
+    std::lock_guard _{ m_map_mutex };
+
+    if (auto t = m_type_map.find(name); t != nullptr) {
+        return *t;
+    }
+
+    return nullptr;
+}
+
+std::vector<REType*> RETypes::copy_types() {
+    std::lock_guard _{ m_map_mutex };
+    return m_type_list;
+}
+
+std::vector<std::string_view> RETypes::get_names() {
+    std::lock_guard _{ m_map_mutex };
+
+    std::vector<std::string_view> names{};
+    names.reserve(m_type_map.size());
+
+    for (auto& entry : m_type_map.get_entries()) {
+        names.push_back(entry.name);
+    }
+
+    return names;
+}
+
 void RETypes::safe_refresh() {
     std::lock_guard _{ m_map_mutex };
     refresh_map();
 }
 
 void RETypes::refresh_map() {
-    auto& typeList = *m_raw_types;
+    const auto old_size = m_type_list.size();
 
     // I don't know why but it can extend past the size.
-    for (auto i = 0; i < typeList.numAllocated; ++i) {
-        auto t = (*typeList.data)[i];
-
+    for (auto t : get_raw_view()) {
         if (t == nullptr || IsBadReadPtr(t, sizeof(REType)) || ((uintptr_t)t & (sizeof(void*) - 1)) != 0) {
             continue;
         }
@@ -103,19 +128,25 @@ void RETypes::refresh_map() {
             continue;
         }
 
-        auto name = std::string{ t->name };
+        auto name = std::string_view{ t->name };
 
         if (name.empty()) {
             continue;
         }
 
-        spdlog::info("{:s}", name);
-
-        m_type_map[name] = t;
+        // Only log the ones we haven't seen, this runs on every lookup miss
+        if (m_type_map.insert_or_assign(name, t)) {
+            spdlog::info("{:s}", name);
+        }
 
-        if (m_types.count(t) == 0) {
-            m_types.insert(t);
+        if (m_types.insert(t)) {
             m_type_list.push_back(t);
         }
     }
+
+    // Only worth rebuilding the hierarchy if something new showed up
+    if (m_type_list.size() != old_size) {
+        sdk::rebuild_type_hierarchy(m_type_list);
+        sdk::rebuild_member_index(m_type_list);
+    }
 }
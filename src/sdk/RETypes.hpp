@@ -1,8 +1,10 @@
 #pragma once
 
 #include <mutex>
-#include <unordered_map>
-#include <unordered_set>
+
+#include "utility/ArrayView.hpp"
+#include "utility/FlatMap.hpp"
+#include "utility/NameTable.hpp"
 
 #include "ReClass.hpp"
 
@@ -11,6 +13,10 @@ std::string game_namespace(std::string_view base_name);
 // A list of types in the RE engine
 class RETypes {
 public:
+    // Every slot of the engine's type list. It can extend past the size,
+    // so entries can be null or garbage and still need checking.
+    using TypeListView = utility::ArrayView<REType*>;
+
     RETypes();
     virtual ~RETypes() {};
 
@@ -18,6 +24,14 @@ public:
         return m_raw_types;
     }
 
+    TypeListView get_raw_view() const {
+        if (m_raw_types == nullptr || m_raw_types->data == nullptr || m_raw_types->numAllocated <= 0) {
+            return {};
+        }
+
+        return { *m_raw_types->data, (size_t)m_raw_types->numAllocated };
+    }
+
     const auto& get_types_set() const {
         return m_types;
     }
@@ -26,10 +40,19 @@ public:
         return m_type_list;
     }
 
+    // get_types grows under the map mutex, this is for threads other than the one doing lookups
+    std::vector<REType*> copy_types();
+
     // Equivalent
     REType* get(std::string_view name);
     REType* operator[](std::string_view name);
 
+    // Like get, but never refreshes the map. For callers that look up names that may not exist (searches, UI).
+    REType* find(std::string_view name);
+
+    // Every known type name. The views point into engine memory, nothing is copied.
+    std::vector<std::string_view> get_names();
+
     template <typename T>
     T* get(std::string_view name) {
         return (T*)get(name);
@@ -44,13 +67,14 @@ private:
     TypeList* m_raw_types{ nullptr };
 
     // Class name to object like "app.foo.bar" -> 0xDEADBEEF
-    std::unordered_map<std::string, REType*> m_type_map;
+    // Keyed by the engine's own name strings, so the names aren't duplicated here.
+    utility::NameTable<REType*> m_type_map;
 
     // Raw list of objects (for if the type hasn't been fully initialized, we need to refresh the map)
-    std::unordered_set<REType*> m_types;
+    utility::FlatSet<REType*> m_types;
     std::vector<REType*> m_type_list;
     // List of objects we've already logged
-    std::unordered_set<REType*> m_acknowledged_types;
+    utility::FlatSet<REType*> m_acknowledged_types;
 
     std::mutex m_map_mutex{};
 };
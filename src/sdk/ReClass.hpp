@@ -14,6 +14,9 @@
 #include "Enums_Internal.hpp"
 
 #include "RETypes.hpp"
+#include "RETypeHierarchy.hpp"
+#include "REMemberIndex.hpp"
+#include "REEnumCatalog.hpp"
 #include "REArray.hpp"
 #include "REContext.hpp"
 #include "REManagedObject.hpp"
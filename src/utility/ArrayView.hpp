@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+namespace utility {
+    // Non-owning view over a contiguous run of T, like std::span (which we don't have in C++17).
+    // Layout checks happen once when the view is made, iterating it is just pointer arithmetic.
+    template <typename T>
+    class ArrayView {
+    public:
+        constexpr ArrayView() = default;
+        constexpr ArrayView(T* data, size_t size)
+            : m_data{ data },
+            m_size{ data != nullptr ? size : 0 }
+        {
+        }
+
+        constexpr T* begin() const { return m_data; }
+        constexpr T* end() const { return m_data + m_size; }
+
+        constexpr T* data() const { return m_data; }
+        constexpr size_t size() const { return m_size; }
+        constexpr bool empty() const { return m_size == 0; }
+
+        constexpr T& operator[](size_t i) const { return m_data[i]; }
+
+        constexpr ArrayView subview(size_t offset, size_t count) const {
+            if (offset >= m_size) {
+                return {};
+            }
+
+            return { m_data + offset, count < m_size - offset ? count : m_size - offset };
+        }
+
+    private:
+        T* m_data{ nullptr };
+        size_t m_size{ 0 };
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ASCII_NARROW_SSE2
+#endif
+
+namespace utility {
+    // Almost every engine name is plain ASCII, which converts by just dropping the high byte.
+    // Returns false (with out untouched) if anything isn't ASCII.
+    // Char is wchar_t on Windows, the SSE2 path only kicks in for 16 bit characters.
+    template <typename Char>
+    static bool narrow_ascii(const Char* data, size_t length, std::string& out) {
+        size_t i = 0;
+
+#ifdef ASCII_NARROW_SSE2
+        if constexpr (sizeof(Char) == 2) {
+            const auto high_mask = _mm_set1_epi16((short)0xFF80);
+            const auto zero = _mm_setzero_si128();
+
+            // Check 16 characters at a time before doing anything
+            for (; i + 16 <= length; i += 16) {
+                const auto a = _mm_loadu_si128((const __m128i*)(data + i));
+                const auto b = _mm_loadu_si128((const __m128i*)(data + i + 8));
+                const auto high = _mm_and_si128(_mm_or_si128(a, b), high_mask);
+
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF) {
+                    return false;
+                }
+            }
+        }
+#endif
+
+        for (auto j = i; j < length; ++j) {
+            if ((uint32_t)data[j] >= 0x80) {
+                return false;
+            }
+        }
+
+        out.resize(length);
+        i = 0;
+
+#ifdef ASCII_NARROW_SSE2
+        if constexpr (sizeof(Char) == 2) {
+            for (; i + 16 <= length; i += 16) {
+                const auto a = _mm_loadu_si128((const __m128i*)(data + i));
+                const auto b = _mm_loadu_si128((const __m128i*)(data + i + 8));
+
+                // Everything is < 0x80 so the saturating pack is just a truncation
+                _mm_storeu_si128((__m128i*)(out.data() + i), _mm_packus_epi16(a, b));
+            }
+        }
+#endif
+
+        for (; i < length; ++i) {
+            out[i] = (char)data[i];
+        }
+
+        return true;
+    }
+}
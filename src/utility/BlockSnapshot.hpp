@@ -0,0 +1,224 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BLOCK_SNAPSHOT_SSE2
+#endif
+
+#include "FlatMap.hpp"
+
+namespace utility {
+    // Copies of a bunch of memory ranges (objects, mostly) in one arena, hashed in 64 byte blocks.
+    // Diffing two snapshots compares the hashes first, only blocks whose hash changed get compared
+    // byte by byte, so mostly unchanged objects cost 8 bytes of reads per 64 of object.
+    // Every range starts on a block boundary in the arena and its last block is zero padded.
+    class BlockSnapshot {
+    public:
+        static constexpr size_t BLOCK_SIZE = 64;
+
+        struct Range {
+            const void* address;
+            uint32_t size;
+            uint32_t first_block; // arena offset / BLOCK_SIZE, also the index of its first hash
+        };
+
+        // A run of bytes that differ, offset is relative to the start of the range
+        struct Change {
+            uint32_t range; // index into the newer snapshot's ranges
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        void reserve(size_t num_ranges, size_t num_bytes) {
+            m_ranges.reserve(num_ranges);
+            m_arena.reserve(num_bytes + num_ranges * BLOCK_SIZE);
+            m_hashes.reserve(num_bytes / BLOCK_SIZE + num_ranges);
+        }
+
+        void clear() {
+            m_ranges.clear();
+            m_arena.clear();
+            m_hashes.clear();
+            m_by_address.clear();
+        }
+
+        // Copies size bytes from address now, the caller makes sure they're readable
+        void add(const void* address, uint32_t size) {
+            const auto num_blocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            const auto first_block = (uint32_t)m_hashes.size();
+
+            m_ranges.push_back({ address, size, first_block });
+            m_arena.resize(m_arena.size() + num_blocks * BLOCK_SIZE);
+
+            auto data = m_arena.data() + (size_t)first_block * BLOCK_SIZE;
+            memcpy(data, address, size);
+
+            for (size_t i = 0; i < num_blocks; ++i) {
+                m_hashes.push_back(hash_block(data + i * BLOCK_SIZE));
+            }
+        }
+
+        const std::vector<Range>& get_ranges() const {
+            return m_ranges;
+        }
+
+        const uint8_t* get_data(const Range& range) const {
+            return m_arena.data() + (size_t)range.first_block * BLOCK_SIZE;
+        }
+
+        size_t get_size() const {
+            return m_arena.size();
+        }
+
+        // What changed from before to this one. Ranges are matched by address, ranges only one
+        // of them has are skipped, ranges that changed size are reported as changed entirely.
+        std::vector<Change> diff(const BlockSnapshot& before) const {
+            std::vector<Change> changes{};
+
+            for (uint32_t i = 0; i < m_ranges.size(); ++i) {
+                auto& range = m_ranges[i];
+                auto old_range = before.find(range.address, i);
+
+                if (old_range == nullptr) {
+                    continue;
+                }
+
+                if (old_range->size != range.size) {
+                    changes.push_back({ i, 0, range.size });
+                    continue;
+                }
+
+                const auto num_blocks = (range.size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+                auto data = get_data(range);
+                auto old_data = before.get_data(*old_range);
+
+                // Open run of changed bytes, can continue into the next block
+                bool in_run = false;
+
+                for (uint32_t b = 0; b < num_blocks; ++b) {
+                    if (m_hashes[range.first_block + b] == before.m_hashes[old_range->first_block + b]) {
+                        in_run = false;
+                        continue;
+                    }
+
+                    const auto mask = diff_block(data + b * BLOCK_SIZE, old_data + b * BLOCK_SIZE);
+
+                    for (uint32_t j = 0; j < BLOCK_SIZE; ++j) {
+                        if ((mask >> j) & 1) {
+                            if (in_run) {
+                                ++changes.back().size;
+                            }
+                            else {
+                                changes.push_back({ i, b * (uint32_t)BLOCK_SIZE + j, 1 });
+                                in_run = true;
+                            }
+                        }
+                        else {
+                            in_run = false;
+                        }
+                    }
+                }
+            }
+
+            return changes;
+        }
+
+        // xxh3 style accumulate: each 64 bit lane adds (lo32 * hi32) of the keyed word plus the word itself
+        static uint64_t hash_block(const uint8_t* block) {
+#ifdef BLOCK_SNAPSHOT_SSE2
+            auto v = _mm_loadu_si128((const __m128i*)HASH_SEED);
+
+            for (size_t i = 0; i < BLOCK_SIZE / 16; ++i) {
+                const auto data = _mm_loadu_si128((const __m128i*)(block + i * 16));
+                const auto key = _mm_loadu_si128((const __m128i*)(HASH_KEYS + i * 2));
+                const auto data_key = _mm_xor_si128(data, key);
+                const auto data_key_hi = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(3, 3, 1, 1));
+
+                v = _mm_add_epi64(v, _mm_add_epi64(_mm_mul_epu32(data_key, data_key_hi), data));
+            }
+
+            uint64_t acc[2]{};
+            _mm_storeu_si128((__m128i*)acc, v);
+
+            return acc[0] ^ (acc[1] * 0x9E3779B97F4A7C15);
+#else
+            return hash_block_scalar(block);
+#endif
+        }
+
+        // Same result as hash_block, a word at a time
+        static uint64_t hash_block_scalar(const uint8_t* block) {
+            uint64_t acc[2]{ HASH_SEED[0], HASH_SEED[1] };
+
+            for (size_t i = 0; i < BLOCK_SIZE / 8; ++i) {
+                uint64_t word{};
+                memcpy(&word, block + i * 8, sizeof(word));
+
+                const auto data_key = word ^ HASH_KEYS[i];
+                acc[i & 1] += (data_key & 0xFFFFFFFF) * (data_key >> 32) + word;
+            }
+
+            return acc[0] ^ (acc[1] * 0x9E3779B97F4A7C15);
+        }
+
+        // Bit n set = byte n differs
+        static uint64_t diff_block(const uint8_t* a, const uint8_t* b) {
+#ifdef BLOCK_SNAPSHOT_SSE2
+            uint64_t mask = 0;
+
+            for (size_t i = 0; i < BLOCK_SIZE / 16; ++i) {
+                const auto eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i * 16)), _mm_loadu_si128((const __m128i*)(b + i * 16)));
+                mask |= (uint64_t)(~_mm_movemask_epi8(eq) & 0xFFFF) << (i * 16);
+            }
+
+            return mask;
+#else
+            return diff_block_scalar(a, b);
+#endif
+        }
+
+        static uint64_t diff_block_scalar(const uint8_t* a, const uint8_t* b) {
+            uint64_t mask = 0;
+
+            for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+                mask |= (uint64_t)(a[i] != b[i]) << i;
+            }
+
+            return mask;
+        }
+
+    private:
+        static constexpr uint64_t HASH_SEED[2]{ 0x9E3779B185EBCA87, 0xC2B2AE3D27D4EB4F };
+        static constexpr uint64_t HASH_KEYS[BLOCK_SIZE / 8]{
+            0xBE4BA423396CFEB8, 0x1CAD21F72C81017C, 0xDB979083E96DD4DE, 0x1F67B3B7A4A44072,
+            0x78E5C0CC4EE679CB, 0x2172FFCC7DD05A82, 0x8E2443F7744608B8, 0x4C263A81E69035E0,
+        };
+
+        // Snapshots taken from the same list line up by index, only fall back to the map when they don't
+        const Range* find(const void* address, uint32_t hint) const {
+            if (hint < m_ranges.size() && m_ranges[hint].address == address) {
+                return &m_ranges[hint];
+            }
+
+            if (m_by_address.empty()) {
+                for (uint32_t i = 0; i < m_ranges.size(); ++i) {
+                    m_by_address.try_emplace(m_ranges[i].address, i);
+                }
+            }
+
+            auto it = m_by_address.find(address);
+            return it != m_by_address.end() ? &m_ranges[it->second] : nullptr;
+        }
+
+        std::vector<Range> m_ranges{};
+        std::vector<uint8_t> m_arena{};
+        std::vector<uint64_t> m_hashes{};
+
+        // Built on the first lookup that misses the index, so diff() on one snapshot from two threads at once isn't safe
+        mutable FlatMap<const void*, uint32_t> m_by_address{};
+    };
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace utility {
+    // Runs func on a worker thread for the latest value handed to post().
+    // Values posted while a run is going replace each other, the next run only sees the last one,
+    // so a burst of posts costs at most two runs. Runs never overlap, results come out in post order.
+    template <typename T>
+    class CoalescingWorker {
+    public:
+        CoalescingWorker(std::function<void(T)> func)
+            : m_func{ std::move(func) }
+        {
+        }
+
+        // wait runs it on the calling thread instead, unless a worker is already busy
+        void post(T value, bool wait = false) {
+            {
+                std::lock_guard _{ m_mutex };
+
+                m_pending = std::move(value);
+
+                // The running one picks it up when it's done
+                if (m_running) {
+                    return;
+                }
+
+                m_running = true;
+            }
+
+            if (wait) {
+                run();
+            }
+            else {
+                std::thread{ [this]() { run(); } }.detach();
+            }
+        }
+
+    private:
+        void run() {
+            while (true) {
+                std::optional<T> value{};
+
+                {
+                    std::lock_guard _{ m_mutex };
+
+                    if (!m_pending) {
+                        m_running = false;
+                        return;
+                    }
+
+                    value = std::move(m_pending);
+                    m_pending.reset();
+                }
+
+                m_func(std::move(*value));
+            }
+        }
+
+        std::function<void(T)> m_func;
+
+        std::mutex m_mutex{};
+        std::optional<T> m_pending{};
+        bool m_running{ false };
+    };
+}
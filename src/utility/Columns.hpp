@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Filling structure of arrays results (a tuple of one vector per column), row by row.
+// Doesn't know where the values come from, read(row, column) does, so it can be driven without the engine.
+namespace utility::columns {
+    template <typename... Columns>
+    using Table = std::tuple<std::vector<Columns>...>;
+
+    namespace detail {
+        template <typename... Columns, typename Read, size_t... I>
+        static void fill(Table<Columns...>& columns, size_t begin, size_t end, Read& read, std::index_sequence<I...>) {
+            for (auto row = begin; row < end; ++row) {
+                ((std::get<I>(columns)[row] = read(row, std::integral_constant<size_t, I>{})), ...);
+            }
+        }
+    }
+
+    // Rows [begin, end) of every column, which have to be sized already.
+    // read(row, column) gets the column as an std::integral_constant and returns that column's value.
+    template <typename... Columns, typename Read>
+    static void fill(Table<Columns...>& columns, size_t begin, size_t end, Read&& read) {
+        // std::vector<bool> packs bits, rows filled from different threads would stomp on each other
+        static_assert(!(std::is_same_v<Columns, bool> || ...), "Use uint8_t for bool columns");
+
+        detail::fill(columns, begin, end, read, std::index_sequence_for<Columns...>{});
+    }
+
+    // Resizes every column to num_rows and fills them, split into contiguous chunks over
+    // up to num_threads threads. 0 or 1 fills on the calling thread.
+    template <typename... Columns, typename Read>
+    static void fill_split(Table<Columns...>& columns, size_t num_rows, size_t num_threads, Read&& read) {
+        std::apply([&](auto&... column) {
+            (column.resize(num_rows), ...);
+        }, columns);
+
+        num_threads = std::min(num_threads, num_rows);
+
+        if (num_threads <= 1) {
+            fill(columns, 0, num_rows, read);
+            return;
+        }
+
+        std::vector<std::thread> threads{};
+        const auto rows_per_thread = (num_rows + num_threads - 1) / num_threads;
+
+        for (size_t i = 0; i < num_threads; ++i) {
+            const auto begin = i * rows_per_thread;
+            const auto end = std::min(begin + rows_per_thread, num_rows);
+
+            if (begin >= end) {
+                break;
+            }
+
+            threads.emplace_back([&columns, &read, begin, end] { fill(columns, begin, end, read); });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "String.hpp"
+
+namespace utility {
+    // Hasher for FlatMap. Every string type goes through the same FNV-1a,
+    // so a map keyed by string_view can be searched with a std::string or const char* and vice versa.
+    struct FlatHash {
+        size_t operator()(std::string_view s) const {
+            return hash(s);
+        }
+
+        size_t operator()(const std::string& s) const {
+            return hash(std::string_view{ s });
+        }
+
+        size_t operator()(const char* s) const {
+            return hash(std::string_view{ s });
+        }
+
+        // Pointers and integers. Pointers are aligned so the low bits are mostly zero, mix them in from the top.
+        template <typename T, std::enable_if_t<std::is_pointer_v<T> || std::is_integral_v<T> || std::is_enum_v<T>, int> = 0>
+        size_t operator()(T v) const {
+            uint64_t x{};
+
+            if constexpr (std::is_pointer_v<T>) {
+                x = (uint64_t)(uintptr_t)v;
+            }
+            else {
+                x = (uint64_t)v;
+            }
+
+            x ^= x >> 33;
+            x *= 0xFF51AFD7ED558CCD;
+            x ^= x >> 33;
+
+            return (size_t)x;
+        }
+    };
+
+    // Open addressing hash map with linear probing, for the registries that get hit every frame.
+    // Everything lives in two flat arrays: the full hash of each slot (0 = empty) and the key/value pairs.
+    // Probing only touches the hash array until a hash matches, and rehashing never calls the hasher again.
+    //
+    // Lookups are heterogeneous (anything Hash and Eq accept), and can take a hash computed ahead of time.
+    // Unlike std::unordered_map, pointers to values don't survive an insert, keep big or non-movable values behind a unique_ptr.
+    template <typename K, typename V, typename Hash = FlatHash, typename Eq = std::equal_to<>>
+    class FlatMap {
+    public:
+        using value_type = std::pair<K, V>;
+
+        template <bool Const>
+        class Iterator {
+        public:
+            using Map = std::conditional_t<Const, const FlatMap, FlatMap>;
+            using Value = std::conditional_t<Const, const value_type, value_type>;
+
+            Iterator(Map* map, size_t i)
+                : m_map{ map },
+                m_i{ i }
+            {
+                skip_empty();
+            }
+
+            Value& operator*() const { return m_map->m_slots[m_i]; }
+            Value* operator->() const { return &m_map->m_slots[m_i]; }
+
+            Iterator& operator++() {
+                ++m_i;
+                skip_empty();
+                return *this;
+            }
+
+            bool operator==(const Iterator& other) const { return m_i == other.m_i; }
+            bool operator!=(const Iterator& other) const { return m_i != other.m_i; }
+
+        private:
+            friend class FlatMap;
+
+            void skip_empty() {
+                while (m_i < m_map->m_hashes.size() && m_map->m_hashes[m_i] == 0) {
+                    ++m_i;
+                }
+            }
+
+            Map* m_map;
+            size_t m_i;
+        };
+
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        iterator begin() { return { this, 0 }; }
+        iterator end() { return { this, m_hashes.size() }; }
+        const_iterator begin() const { return { this, 0 }; }
+        const_iterator end() const { return { this, m_hashes.size() }; }
+
+        size_t size() const {
+            return m_size;
+        }
+
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        void clear() {
+            m_hashes.clear();
+            m_slots.clear();
+            m_size = 0;
+        }
+
+        void reserve(size_t n) {
+            // Keep the load factor at or under 3/4
+            auto capacity = MIN_CAPACITY;
+
+            while (capacity * 3 / 4 < n) {
+                capacity *= 2;
+            }
+
+            if (capacity > m_hashes.size()) {
+                rehash(capacity);
+            }
+        }
+
+        template <typename Q>
+        iterator find(const Q& key) {
+            return find(key, hash_key(key));
+        }
+
+        template <typename Q>
+        const_iterator find(const Q& key) const {
+            return find(key, hash_key(key));
+        }
+
+        // h must be what Hash gives for key
+        template <typename Q>
+        iterator find(const Q& key, size_t h) {
+            return { this, find_slot(key, fix_hash(h)) };
+        }
+
+        template <typename Q>
+        const_iterator find(const Q& key, size_t h) const {
+            return { this, find_slot(key, fix_hash(h)) };
+        }
+
+        template <typename Q>
+        size_t count(const Q& key) const {
+            return find_slot(key, hash_key(key)) != m_hashes.size() ? 1 : 0;
+        }
+
+        template <typename Q>
+        V& operator[](Q&& key) {
+            return try_emplace(std::forward<Q>(key)).first->second;
+        }
+
+        template <typename Q, typename... Args>
+        std::pair<iterator, bool> try_emplace(Q&& key, Args&&... args) {
+            const auto h = hash_key(key);
+            return try_emplace_hashed(h, std::forward<Q>(key), std::forward<Args>(args)...);
+        }
+
+        // h must be what Hash gives for key
+        template <typename Q, typename... Args>
+        std::pair<iterator, bool> try_emplace_hashed(size_t h, Q&& key, Args&&... args) {
+            h = fix_hash(h);
+
+            if (auto i = find_slot(key, h); i != m_hashes.size()) {
+                return { { this, i }, false };
+            }
+
+            grow_if_needed();
+
+            auto i = h & (m_hashes.size() - 1);
+
+            while (m_hashes[i] != 0) {
+                i = (i + 1) & (m_hashes.size() - 1);
+            }
+
+            m_hashes[i] = h;
+            m_slots[i] = value_type{ K(std::forward<Q>(key)), V(std::forward<Args>(args)...) };
+            ++m_size;
+
+            return { { this, i }, true };
+        }
+
+        template <typename Q, typename T>
+        std::pair<iterator, bool> insert_or_assign(Q&& key, T&& value) {
+            auto result = try_emplace(std::forward<Q>(key));
+            result.first->second = std::forward<T>(value);
+            return result;
+        }
+
+        template <typename Q>
+        size_t erase(const Q& key) {
+            auto i = find_slot(key, hash_key(key));
+
+            if (i == m_hashes.size()) {
+                return 0;
+            }
+
+            // Backward shift instead of tombstones, so lookups never have to step over dead slots
+            const auto mask = m_hashes.size() - 1;
+
+            for (auto j = (i + 1) & mask; m_hashes[j] != 0; j = (j + 1) & mask) {
+                const auto home = m_hashes[j] & mask;
+
+                // Can slot j move back into the hole at i without passing its home slot?
+                if (((j - home) & mask) >= ((j - i) & mask)) {
+                    m_hashes[i] = m_hashes[j];
+                    m_slots[i] = std::move(m_slots[j]);
+                    i = j;
+                }
+            }
+
+            m_hashes[i] = 0;
+            m_slots[i] = value_type{};
+            --m_size;
+
+            return 1;
+        }
+
+    private:
+        static constexpr size_t MIN_CAPACITY = 16;
+
+        // 0 marks an empty slot
+        static size_t fix_hash(size_t h) {
+            return h != 0 ? h : 1;
+        }
+
+        template <typename Q>
+        size_t hash_key(const Q& key) const {
+            return fix_hash(Hash{}(key));
+        }
+
+        template <typename Q>
+        size_t find_slot(const Q& key, size_t h) const {
+            if (m_size == 0) {
+                return m_hashes.size();
+            }
+
+            const auto mask = m_hashes.size() - 1;
+
+            for (auto i = h & mask; m_hashes[i] != 0; i = (i + 1) & mask) {
+                if (m_hashes[i] == h && Eq{}(m_slots[i].first, key)) {
+                    return i;
+                }
+            }
+
+            return m_hashes.size();
+        }
+
+        void grow_if_needed() {
+            if (m_hashes.empty()) {
+                rehash(MIN_CAPACITY);
+            }
+            else if ((m_size + 1) * 4 > m_hashes.size() * 3) {
+                rehash(m_hashes.size() * 2);
+            }
+        }
+
+        void rehash(size_t capacity) {
+            std::vector<size_t> hashes(capacity);
+            std::vector<value_type> slots(capacity);
+
+            const auto mask = capacity - 1;
+
+            for (size_t j = 0; j < m_hashes.size(); ++j) {
+                if (m_hashes[j] == 0) {
+                    continue;
+                }
+
+                auto i = m_hashes[j] & mask;
+
+                while (hashes[i] != 0) {
+                    i = (i + 1) & mask;
+                }
+
+                hashes[i] = m_hashes[j];
+                slots[i] = std::move(m_slots[j]);
+            }
+
+            m_hashes = std::move(hashes);
+            m_slots = std::move(slots);
+        }
+
+        std::vector<size_t> m_hashes{};
+        std::vector<value_type> m_slots{};
+        size_t m_size{ 0 };
+    };
+
+    // FlatMap without the values
+    template <typename K, typename Hash = FlatHash, typename Eq = std::equal_to<>>
+    class FlatSet {
+    public:
+        template <typename Q>
+        bool insert(Q&& key) {
+            return m_map.try_emplace(std::forward<Q>(key)).second;
+        }
+
+        template <typename Q>
+        size_t count(const Q& key) const {
+            return m_map.count(key);
+        }
+
+        template <typename Q>
+        size_t erase(const Q& key) {
+            return m_map.erase(key);
+        }
+
+        size_t size() const { return m_map.size(); }
+        bool empty() const { return m_map.empty(); }
+        void clear() { m_map.clear(); }
+        void reserve(size_t n) { m_map.reserve(n); }
+
+        template <typename F>
+        void for_each(F&& func) const {
+            for (auto& it : m_map) {
+                func(it.first);
+            }
+        }
+
+    private:
+        struct Empty {};
+
+        FlatMap<K, Empty, Hash, Eq> m_map{};
+    };
+}
@@ -0,0 +1,393 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FlatMap.hpp"
+
+namespace utility {
+    // Walks everything reachable from a set of roots on a small work-stealing pool.
+    // Each worker pops its own queue from the back (depth first, stays in cache) and steals
+    // from the front of the others when it runs dry. The visited set is sharded so workers
+    // only contend when they touch the same shard at the same time.
+    //
+    // The graph itself comes from the adapter, which keeps this testable without a game:
+    //   using Node = ...;  // pointer or integer, anything FlatHash takes. Node{} is never a real node.
+    //   using Type = ...;  // same
+    //   using Edge = ...;  // what a reference is (a field, an array slot), only stored for paths
+    //   Type get_type(Node) const;
+    //   size_t get_size(Node) const;
+    //   void for_each_ref(Node, F&& func) const;  // func(Node target, Edge edge) for every valid outgoing reference
+    // The adapter gets called from several threads at once.
+    //
+    // Retained size is worked out per root: an object is retained by a root if nothing else
+    // reaches it, everything reachable from two or more roots is counted as shared.
+    template <typename Adapter>
+    class GraphWalker {
+    public:
+        using Node = typename Adapter::Node;
+        using Type = typename Adapter::Type;
+        using Edge = typename Adapter::Edge;
+
+        struct TypeStats {
+            size_t count{ 0 };
+            size_t size{ 0 };
+            Node sample{}; // one instance, for get_path
+        };
+
+        struct RootStats {
+            size_t count{ 0 };
+            size_t size{ 0 };
+        };
+
+        // One hop of a reference path, edge is how node was reached from the previous step
+        struct Step {
+            Node node;
+            Edge edge;
+        };
+
+        GraphWalker(Adapter adapter, size_t num_threads = 0)
+            : m_adapter{ std::move(adapter) }
+        {
+            if (num_threads == 0) {
+                num_threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 16);
+            }
+
+            for (size_t i = 0; i < num_threads; ++i) {
+                m_workers.push_back(std::make_unique<Worker>());
+            }
+        }
+
+        // Blocks until everything reachable from roots has been visited, the calling thread works too.
+        // Only call it once per walker.
+        void walk(const std::vector<Node>& roots) {
+            m_root_nodes = roots;
+            m_roots.resize(roots.size());
+
+            for (auto& worker : m_workers) {
+                worker->roots.resize(roots.size());
+            }
+
+            // Pass 1: visit everything, remember where two roots met
+            std::vector<Item> seeds{};
+
+            for (uint32_t i = 0; i < roots.size(); ++i) {
+                if (roots[i] != Node{} && claim(*m_workers[0], roots[i], Node{}, Edge{}, i)) {
+                    seeds.push_back({ roots[i], i });
+                }
+            }
+
+            run(std::move(seeds), [this](Worker& worker, const Item& item) { visit(worker, item); });
+
+            // Pass 2: everything below a meeting point is shared, take it back off its root
+            seeds.clear();
+
+            for (auto& worker : m_workers) {
+                seeds.insert(seeds.end(), worker->shared_seeds.begin(), worker->shared_seeds.end());
+                worker->shared_seeds.clear();
+            }
+
+            run(std::move(seeds), [this](Worker& worker, const Item& item) { share(worker, item); });
+
+            // Merge what the workers counted
+            for (auto& worker : m_workers) {
+                for (auto& [t, stats] : worker->type_stats) {
+                    auto& total = m_type_stats[t];
+
+                    if (total.count == 0) {
+                        total.sample = stats.sample;
+                    }
+
+                    total.count += stats.count;
+                    total.size += stats.size;
+                }
+
+                for (size_t i = 0; i < m_roots.size(); ++i) {
+                    m_roots[i].count += (size_t)worker->roots[i].count;
+                    m_roots[i].size += (size_t)worker->roots[i].size;
+                }
+
+                m_shared.count += worker->shared.count;
+                m_shared.size += worker->shared.size;
+                m_total.count += worker->total.count;
+                m_total.size += worker->total.size;
+            }
+        }
+
+        const FlatMap<Type, TypeStats>& get_type_stats() const {
+            return m_type_stats;
+        }
+
+        const std::vector<Node>& get_roots() const {
+            return m_root_nodes;
+        }
+
+        // Same order as get_roots
+        const std::vector<RootStats>& get_root_stats() const {
+            return m_roots;
+        }
+
+        // Reachable from more than one root
+        const RootStats& get_shared_stats() const {
+            return m_shared;
+        }
+
+        const RootStats& get_total_stats() const {
+            return m_total;
+        }
+
+        bool contains(Node node) const {
+            auto& shard = get_shard(node);
+            return shard.map.count(node) > 0;
+        }
+
+        // Every node the walk reached, in no particular order
+        template <typename F>
+        void for_each_node(F&& func) const {
+            for (auto& shard : m_shards) {
+                for (auto& [node, visit] : shard.map) {
+                    func(node);
+                }
+            }
+        }
+
+        // How the walk first got to node, starting at its root. Empty if it wasn't reached.
+        std::vector<Step> get_path(Node node) const {
+            std::vector<Step> path{};
+
+            while (node != Node{} && path.size() <= m_total.count) {
+                auto& shard = get_shard(node);
+                auto it = shard.map.find(node);
+
+                if (it == shard.map.end()) {
+                    break;
+                }
+
+                path.push_back({ node, it->second.edge });
+                node = it->second.parent;
+            }
+
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+        const Adapter& get_adapter() const {
+            return m_adapter;
+        }
+
+    private:
+        struct Item {
+            Node node;
+            uint32_t root;
+        };
+
+        struct Visit {
+            Node parent; // Node{} for roots
+            Edge edge;
+            uint32_t root;
+            bool shared;
+        };
+
+        // Signed, pass 2 can take off a worker what another one added
+        struct SignedStats {
+            int64_t count{ 0 };
+            int64_t size{ 0 };
+        };
+
+        struct Worker {
+            std::mutex mutex{};
+            std::deque<Item> queue{};
+
+            FlatMap<Type, TypeStats> type_stats{};
+            std::vector<SignedStats> roots{};
+            RootStats shared{};
+            RootStats total{};
+            std::vector<Item> shared_seeds{};
+        };
+
+        struct Shard {
+            std::mutex mutex{};
+            FlatMap<Node, Visit> map{};
+        };
+
+        static constexpr size_t NUM_SHARDS = 64;
+
+        Shard& get_shard(Node node) {
+            return m_shards[(FlatHash{}(node) >> 58) % NUM_SHARDS];
+        }
+
+        const Shard& get_shard(Node node) const {
+            return m_shards[(FlatHash{}(node) >> 58) % NUM_SHARDS];
+        }
+
+        // First one to get here owns node. Anyone else coming from another root marks it shared.
+        bool claim(Worker& worker, Node node, Node parent, const Edge& edge, uint32_t root) {
+            auto& shard = get_shard(node);
+            std::lock_guard _{ shard.mutex };
+
+            auto [it, inserted] = shard.map.try_emplace(node, Visit{ parent, edge, root, false });
+
+            if (!inserted && it->second.root != root && !it->second.shared) {
+                it->second.shared = true;
+                worker.shared_seeds.push_back({ node, it->second.root });
+            }
+
+            return inserted;
+        }
+
+        void visit(Worker& worker, const Item& item) {
+            const auto size = m_adapter.get_size(item.node);
+            auto& stats = worker.type_stats[m_adapter.get_type(item.node)];
+
+            if (stats.count == 0) {
+                stats.sample = item.node;
+            }
+
+            ++stats.count;
+            stats.size += size;
+
+            ++worker.roots[item.root].count;
+            worker.roots[item.root].size += (int64_t)size;
+            ++worker.total.count;
+            worker.total.size += size;
+
+            m_adapter.for_each_ref(item.node, [&](Node target, const Edge& edge) {
+                if (target != Node{} && claim(worker, target, item.node, edge, item.root)) {
+                    push(worker, { target, item.root });
+                }
+            });
+        }
+
+        void share(Worker& worker, const Item& item) {
+            const auto size = m_adapter.get_size(item.node);
+
+            --worker.roots[item.root].count;
+            worker.roots[item.root].size -= (int64_t)size;
+            ++worker.shared.count;
+            worker.shared.size += size;
+
+            m_adapter.for_each_ref(item.node, [&](Node target, const Edge&) {
+                if (target == Node{}) {
+                    return;
+                }
+
+                auto& shard = get_shard(target);
+                std::unique_lock lock{ shard.mutex };
+
+                // Not there means it showed up after pass 1 (the game keeps running), leave it alone
+                auto it = shard.map.find(target);
+
+                if (it == shard.map.end() || it->second.shared) {
+                    return;
+                }
+
+                it->second.shared = true;
+                const auto root = it->second.root;
+
+                lock.unlock();
+                push(worker, { target, root });
+            });
+        }
+
+        void push(Worker& worker, const Item& item) {
+            m_pending.fetch_add(1, std::memory_order_relaxed);
+
+            std::lock_guard _{ worker.mutex };
+            worker.queue.push_back(item);
+        }
+
+        bool pop(Worker& worker, Item& item) {
+            std::lock_guard _{ worker.mutex };
+
+            if (worker.queue.empty()) {
+                return false;
+            }
+
+            item = worker.queue.back();
+            worker.queue.pop_back();
+
+            return true;
+        }
+
+        bool steal(size_t thief, Item& item) {
+            for (size_t i = 1; i < m_workers.size(); ++i) {
+                auto& victim = *m_workers[(thief + i) % m_workers.size()];
+                std::lock_guard _{ victim.mutex };
+
+                if (!victim.queue.empty()) {
+                    item = victim.queue.front();
+                    victim.queue.pop_front();
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        template <typename F>
+        void run(std::vector<Item> seeds, F process) {
+            if (seeds.empty()) {
+                return;
+            }
+
+            m_pending.store(seeds.size());
+
+            for (size_t i = 0; i < seeds.size(); ++i) {
+                m_workers[i % m_workers.size()]->queue.push_back(seeds[i]);
+            }
+
+            auto work = [&](size_t index) {
+                auto& worker = *m_workers[index];
+                Item item{};
+
+                while (true) {
+                    if (pop(worker, item) || steal(index, item)) {
+                        process(worker, item);
+
+                        // Only after its children got queued, so 0 really means done
+                        m_pending.fetch_sub(1, std::memory_order_acq_rel);
+                        continue;
+                    }
+
+                    if (m_pending.load(std::memory_order_acquire) == 0) {
+                        break;
+                    }
+
+                    std::this_thread::yield();
+                }
+            };
+
+            std::vector<std::thread> threads{};
+
+            for (size_t i = 1; i < m_workers.size(); ++i) {
+                threads.emplace_back(work, i);
+            }
+
+            work(0);
+
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        Adapter m_adapter;
+
+        std::vector<std::unique_ptr<Worker>> m_workers{};
+        std::array<Shard, NUM_SHARDS> m_shards{};
+        std::atomic<size_t> m_pending{ 0 };
+
+        FlatMap<Type, TypeStats> m_type_stats{};
+        std::vector<Node> m_root_nodes{};
+        std::vector<RootStats> m_roots{};
+        RootStats m_shared{};
+        RootStats m_total{};
+    };
+}
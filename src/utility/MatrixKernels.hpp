@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+
+#include <xmmintrin.h>
+
+// Operations on whole arrays of 4x4 matrices at once, see re_pose for the joint side of things.
+// Each matrix is 16 floats, column major (glm layout), the last column being the translation.
+// Plain floats so none of this needs the engine or glm.
+// SSE only, the project isn't built with /arch:AVX.
+namespace utility::matrix_kernels {
+    static constexpr int32_t MATRIX_FLOATS = 16;
+
+    // Multiply the rotation/scale part (first 3 columns) of each matrix by s, leaving the translation alone.
+    // s = 0 collapses the matrices in place.
+    static void scale(float* mats, int32_t count, float s) {
+        // Straight stores, so garbage (NaN/inf) in the source can't survive the multiply
+        if (s == 0.0f) {
+            const auto zero = _mm_setzero_ps();
+
+            for (int32_t i = 0; i < count; ++i) {
+                auto m = mats + i * MATRIX_FLOATS;
+
+                _mm_storeu_ps(m + 0, zero);
+                _mm_storeu_ps(m + 4, zero);
+                _mm_storeu_ps(m + 8, zero);
+            }
+
+            return;
+        }
+
+        const auto factor = _mm_set1_ps(s);
+
+        for (int32_t i = 0; i < count; ++i) {
+            auto m = mats + i * MATRIX_FLOATS;
+
+            _mm_storeu_ps(m + 0, _mm_mul_ps(_mm_loadu_ps(m + 0), factor));
+            _mm_storeu_ps(m + 4, _mm_mul_ps(_mm_loadu_ps(m + 4), factor));
+            _mm_storeu_ps(m + 8, _mm_mul_ps(_mm_loadu_ps(m + 8), factor));
+        }
+    }
+
+    static void copy(float* dst, const float* src, int32_t count) {
+        for (int32_t i = 0; i < count; ++i) {
+            auto d = dst + i * MATRIX_FLOATS;
+            auto s = src + i * MATRIX_FLOATS;
+
+            _mm_storeu_ps(d + 0, _mm_loadu_ps(s + 0));
+            _mm_storeu_ps(d + 4, _mm_loadu_ps(s + 4));
+            _mm_storeu_ps(d + 8, _mm_loadu_ps(s + 8));
+            _mm_storeu_ps(d + 12, _mm_loadu_ps(s + 12));
+        }
+    }
+
+    // dst = a + (b - a) * t, per element. dst may alias a or b.
+    // Not a proper rotation interpolation, fine for small differences between poses.
+    static void blend(float* dst, const float* a, const float* b, int32_t count, float t) {
+        const auto factor = _mm_set1_ps(t);
+
+        for (int32_t i = 0; i < count; ++i) {
+            auto d = dst + i * MATRIX_FLOATS;
+            auto pa = a + i * MATRIX_FLOATS;
+            auto pb = b + i * MATRIX_FLOATS;
+
+            for (int32_t k = 0; k < MATRIX_FLOATS; k += 4) {
+                const auto va = _mm_loadu_ps(pa + k);
+                const auto vb = _mm_loadu_ps(pb + k);
+
+                _mm_storeu_ps(d + k, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), factor)));
+            }
+        }
+    }
+
+    // mats[i] = root * mats[i]
+    static void multiply(float* mats, int32_t count, const float* root) {
+        const __m128 root_cols[4]{ _mm_loadu_ps(root + 0), _mm_loadu_ps(root + 4), _mm_loadu_ps(root + 8), _mm_loadu_ps(root + 12) };
+
+        for (int32_t i = 0; i < count; ++i) {
+            auto m = mats + i * MATRIX_FLOATS;
+            __m128 result[4];
+
+            // Each result column is root's columns weighted by the source column
+            for (int32_t c = 0; c < 4; ++c) {
+                const auto col = m + c * 4;
+
+                auto v = _mm_mul_ps(root_cols[0], _mm_set1_ps(col[0]));
+                v = _mm_add_ps(v, _mm_mul_ps(root_cols[1], _mm_set1_ps(col[1])));
+                v = _mm_add_ps(v, _mm_mul_ps(root_cols[2], _mm_set1_ps(col[2])));
+                v = _mm_add_ps(v, _mm_mul_ps(root_cols[3], _mm_set1_ps(col[3])));
+
+                result[c] = v;
+            }
+
+            for (int32_t c = 0; c < 4; ++c) {
+                _mm_storeu_ps(m + c * 4, result[c]);
+            }
+        }
+    }
+}
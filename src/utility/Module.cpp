@@ -33,6 +33,26 @@ namespace utility {
         return ntHeaders->OptionalHeader.SizeOfImage;
     }
 
+    optional<uint32_t> get_module_timestamp(HMODULE module) {
+        if (module == nullptr) {
+            return {};
+        }
+
+        auto dosHeader = (PIMAGE_DOS_HEADER)module;
+
+        if (dosHeader->e_magic != IMAGE_DOS_SIGNATURE) {
+            return {};
+        }
+
+        auto ntHeaders = (PIMAGE_NT_HEADERS)((uintptr_t)dosHeader + dosHeader->e_lfanew);
+
+        if (ntHeaders->Signature != IMAGE_NT_SIGNATURE) {
+            return {};
+        }
+
+        return ntHeaders->FileHeader.TimeDateStamp;
+    }
+
     std::optional<std::string> get_module_directory(HMODULE module) {
         wchar_t fileName[MAX_PATH]{ 0 };
         if (GetModuleFileNameW(module, fileName, MAX_PATH) >= MAX_PATH) {
@@ -13,6 +13,9 @@ namespace utility {
     std::optional<size_t> get_module_size(const std::string& module);
     std::optional<size_t> get_module_size(HMODULE module);
 
+    // TimeDateStamp from the PE header, changes with every build of the module.
+    std::optional<uint32_t> get_module_timestamp(HMODULE module);
+
     std::optional<std::string> get_module_directory(HMODULE module);
 
     // Note: This function doesn't validate the dll's headers so make sure you've
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "FlatMap.hpp"
+
+namespace utility {
+    // Name -> T lookup for names that outlive the table, like the type and enum names in engine memory.
+    // Only views are stored, never copies. Each name is hashed once on insert,
+    // lookups hash the key once and only compare strings when the hashes match.
+    template <typename T>
+    class NameTable {
+    public:
+        struct Entry {
+            std::string_view name;
+            size_t hash;
+            T value;
+        };
+
+        // Returns the value for name, inserting a default one first if it isn't there.
+        T& operator[](std::string_view name) {
+            const auto h = hash(name);
+
+            if (auto i = find_index(name, h); i != NPOS) {
+                return m_entries[i].value;
+            }
+
+            return insert_new(name, h, T{});
+        }
+
+        // Returns true if the name was new.
+        bool insert_or_assign(std::string_view name, T value) {
+            const auto h = hash(name);
+
+            if (auto i = find_index(name, h); i != NPOS) {
+                m_entries[i].value = std::move(value);
+                return false;
+            }
+
+            insert_new(name, h, std::move(value));
+            return true;
+        }
+
+        T* find(std::string_view name) {
+            auto i = find_index(name, hash(name));
+            return i != NPOS ? &m_entries[i].value : nullptr;
+        }
+
+        const T* find(std::string_view name) const {
+            auto i = find_index(name, hash(name));
+            return i != NPOS ? &m_entries[i].value : nullptr;
+        }
+
+        // In insertion order
+        const std::vector<Entry>& get_entries() const {
+            return m_entries;
+        }
+
+        size_t size() const {
+            return m_entries.size();
+        }
+
+        bool empty() const {
+            return m_entries.empty();
+        }
+
+        void reserve(size_t n) {
+            m_entries.reserve(n);
+            m_indices.reserve(n);
+        }
+
+        void clear() {
+            m_entries.clear();
+            m_indices.clear();
+        }
+
+    private:
+        static constexpr uint32_t NPOS = (uint32_t)-1;
+
+        uint32_t find_index(std::string_view name, size_t h) const {
+            auto it = m_indices.find(name, h);
+            return it != m_indices.end() ? it->second : NPOS;
+        }
+
+        T& insert_new(std::string_view name, size_t h, T value) {
+            m_indices.try_emplace_hashed(h, name, (uint32_t)m_entries.size());
+            return m_entries.emplace_back(Entry{ name, h, std::move(value) }).value;
+        }
+
+        std::vector<Entry> m_entries{};
+        FlatMap<std::string_view, uint32_t> m_indices{};
+    };
+}
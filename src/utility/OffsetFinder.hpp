@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace utility {
+    // Works out which offset of an object a getter reads by calling it on a copy of the object.
+    // Nothing here knows about the engine, the getter is anything callable as
+    //   bool getter(uint8_t* obj, uint8_t* out);  // false if the call blew up, out holds OUTPUT_SIZE bytes
+    //
+    // Pointer sized slots that hold a pointer are never scribbled over (except with another pointer
+    // by find_pointer), getters for other fields may follow them and garbage there would get dereferenced.
+    class OffsetFinder {
+    public:
+        static constexpr size_t OUTPUT_SIZE = 0x100;
+        static constexpr size_t SLOT_SIZE = sizeof(void*);
+
+        // The first header_size bytes are left alone, the getters need them.
+        // is_pointer(uintptr_t value) says whether a slot's value is a pointer a getter could follow.
+        template <typename IsPointer>
+        OffsetFinder(const uint8_t* obj, size_t size, size_t header_size, IsPointer&& is_pointer)
+            : m_original(obj, obj + size),
+            m_pattern(obj, obj + size),
+            m_pointer_slots(size / SLOT_SIZE),
+            m_header_size{ header_size }
+        {
+            for (size_t slot = 0; slot < m_pointer_slots.size(); ++slot) {
+                uintptr_t value{};
+                memcpy(&value, obj + slot * SLOT_SIZE, sizeof(value));
+
+                m_pointer_slots[slot] = slot * SLOT_SIZE >= header_size && is_pointer(value);
+            }
+
+            // Every other byte gets a value that differs from its neighbours so short runs of it point back at one offset.
+            for (auto i = header_size; i < size; ++i) {
+                if (!is_pointer_byte(i)) {
+                    m_pattern[i] = (uint8_t)((i * 0x9D) ^ (i >> 8) ^ 0x5A);
+                }
+            }
+        }
+
+        // One call to see what comes out of the patterned copy plus one per candidate to confirm it.
+        // Only finds getters that hand back the field's bytes as they are, 0 if it can't tell.
+        template <typename Getter>
+        int32_t find(Getter&& getter) {
+            // Fill the output with two different values to find out how many bytes the getter writes.
+            std::array<uint8_t, OUTPUT_SIZE> out_a{};
+            std::array<uint8_t, OUTPUT_SIZE> out_b{};
+            out_a.fill(0xCC);
+            out_b.fill(0x33);
+
+            if (!getter(m_pattern.data(), out_a.data()) || !getter(m_pattern.data(), out_b.data())) {
+                return 0;
+            }
+
+            size_t width = 0;
+
+            for (size_t i = 0; i < out_a.size(); ++i) {
+                if (out_a[i] != 0xCC || out_b[i] != 0x33) {
+                    width = i + 1;
+                }
+            }
+
+            // Nothing written, or something bigger than we can reasonably match.
+            if (width == 0 || width > SLOT_SIZE * 2) {
+                return 0;
+            }
+
+            const auto match_width = std::min<size_t>(width, SLOT_SIZE);
+
+            // The getter copied a run of the pattern out of the object, locate it.
+            for (auto i = m_header_size; i + match_width <= m_pattern.size(); ++i) {
+                if (overlaps_pointer(i, match_width) || memcmp(m_pattern.data() + i, out_a.data(), match_width) != 0) {
+                    continue;
+                }
+
+                // Confirm by flipping every byte of it and checking the whole value follows.
+                std::array<uint8_t, OUTPUT_SIZE> out_c{};
+                std::array<uint8_t, SLOT_SIZE> old{};
+                memcpy(old.data(), m_pattern.data() + i, match_width);
+
+                for (size_t j = 0; j < match_width; ++j) {
+                    m_pattern[i + j] ^= 0xFF;
+                }
+
+                const auto called = getter(m_pattern.data(), out_c.data());
+                const auto follows = called && memcmp(out_c.data(), m_pattern.data() + i, match_width) == 0;
+                memcpy(m_pattern.data() + i, old.data(), match_width);
+
+                if (follows) {
+                    return (int32_t)i;
+                }
+            }
+
+            return 0;
+        }
+
+        // For fields holding a reference, the getter hands back the pointer itself.
+        // Look for it among the slots and confirm by swapping stand_in (some other valid pointer) in.
+        template <typename Getter>
+        int32_t find_pointer(Getter&& getter, uintptr_t stand_in) {
+            std::array<uint8_t, OUTPUT_SIZE> out{};
+
+            if (!getter(m_original.data(), out.data())) {
+                return 0;
+            }
+
+            uintptr_t value{};
+            memcpy(&value, out.data(), sizeof(value));
+
+            // Null is everywhere, nothing to go on
+            if (value == 0 || value == stand_in) {
+                return 0;
+            }
+
+            for (auto i = (m_header_size + SLOT_SIZE - 1) / SLOT_SIZE * SLOT_SIZE; i + SLOT_SIZE <= m_original.size(); i += SLOT_SIZE) {
+                if (memcmp(m_original.data() + i, &value, sizeof(value)) != 0) {
+                    continue;
+                }
+
+                memcpy(m_original.data() + i, &stand_in, sizeof(stand_in));
+
+                const auto called = getter(m_original.data(), out.data());
+                const auto follows = called && memcmp(out.data(), &stand_in, sizeof(stand_in)) == 0;
+                memcpy(m_original.data() + i, &value, sizeof(value));
+
+                if (follows) {
+                    return (int32_t)i;
+                }
+            }
+
+            return 0;
+        }
+
+        // The old way, a byte at a time: the getter's first byte has to match the object's
+        // before and after flipping a bit of it. Two calls per byte, but it copes with getters
+        // that don't hand back the raw bytes (bools, mostly).
+        template <typename Getter>
+        int32_t find_bytewise(Getter&& getter) {
+            for (auto i = m_header_size; i < m_original.size(); ++i) {
+                if (is_pointer_byte(i)) {
+                    continue;
+                }
+
+                auto& byte = m_original[i];
+                const auto old = byte;
+                bool same = true;
+
+                // Compare data twice, first run no modifications,
+                // second run, slightly modify the data to double check if it's what we want.
+                for (int32_t k = 0; k < 2; ++k) {
+                    std::array<uint8_t, OUTPUT_SIZE> data{ 0 };
+
+                    if (!getter(m_original.data(), data.data()) || data[0] != byte) {
+                        same = false;
+                        break;
+                    }
+
+                    byte ^= 1;
+                }
+
+                byte = old;
+
+                if (same) {
+                    return (int32_t)i;
+                }
+            }
+
+            return 0;
+        }
+
+        const std::vector<uint8_t>& get_pattern() const {
+            return m_pattern;
+        }
+
+    private:
+        bool is_pointer_byte(size_t offset) const {
+            const auto slot = offset / SLOT_SIZE;
+            return slot < m_pointer_slots.size() && m_pointer_slots[slot];
+        }
+
+        bool overlaps_pointer(size_t offset, size_t size) const {
+            return is_pointer_byte(offset) || is_pointer_byte(offset + size - 1);
+        }
+
+        std::vector<uint8_t> m_original;
+        std::vector<uint8_t> m_pattern;
+        std::vector<bool> m_pointer_slots;
+        size_t m_header_size;
+    };
+}
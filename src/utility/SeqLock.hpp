@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace utility {
+    // Sequence lock around a value.
+    // Readers never block, they retry if a write happened while they were copying.
+    // Writers only wait on other writers, and only for the length of a copy.
+    // T is copied with memcpy, so it has to be plain data (matrices, vectors, structs of those).
+    template <typename T>
+    class SeqLock {
+        static_assert(std::is_trivially_destructible_v<T>, "SeqLock needs a plain data type");
+
+    public:
+        SeqLock() = default;
+        SeqLock(const T& value) {
+            std::memcpy(&m_value, &value, sizeof(T));
+        }
+
+        T load() const {
+            T out{};
+
+            while (true) {
+                const auto before = m_sequence.load(std::memory_order_acquire);
+
+                // Write in progress
+                if ((before & 1) != 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::memcpy(&out, (const void*)&m_value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (m_sequence.load(std::memory_order_relaxed) == before) {
+                    return out;
+                }
+            }
+        }
+
+        void store(const T& value) {
+            const auto sequence = begin_write();
+
+            std::memcpy((void*)&m_value, &value, sizeof(T));
+
+            end_write(sequence);
+        }
+
+        // Read-modify-write, func gets a copy and returns the new value.
+        // Other writers are held off for the duration, so keep it short and don't call into the engine.
+        template <typename F>
+        void update(F&& func) {
+            const auto sequence = begin_write();
+
+            T value{};
+            std::memcpy(&value, (const void*)&m_value, sizeof(T));
+            value = func(value);
+            std::memcpy((void*)&m_value, &value, sizeof(T));
+
+            end_write(sequence);
+        }
+
+    private:
+        uint32_t begin_write() {
+            auto sequence = m_sequence.load(std::memory_order_relaxed);
+
+            // Odd means someone else is writing
+            while ((sequence & 1) != 0 || !m_sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                std::this_thread::yield();
+                sequence = m_sequence.load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_release);
+
+            return sequence;
+        }
+
+        void end_write(uint32_t sequence) {
+            m_sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        std::atomic<uint32_t> m_sequence{ 0 };
+        T m_value{};
+    };
+}
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace utility {
+    // Uniform grid over 3D points, rebuilt in one go rather than updated per point.
+    // Items are sorted by cell so each cell is a contiguous run, queries only look at the cells they touch.
+    template <typename T>
+    class SpatialHash {
+    public:
+        struct Item {
+            float x, y, z;
+            T value;
+        };
+
+        // a * x + b * y + c * z + d >= 0 is inside
+        using Plane = std::array<float, 4>;
+        // left, right, bottom, top, near, far
+        using Frustum = std::array<Plane, 6>;
+
+        SpatialHash(float cell_size = 5.0f)
+            : m_cell_size{ cell_size },
+            m_inv_cell_size{ 1.0f / cell_size }
+        {
+        }
+
+        // Items that aren't at a finite position (NaN from a broken transform, mostly) are left out
+        void build(std::vector<Item> items) {
+            m_cells.clear();
+            m_items = std::move(items);
+
+            m_items.erase(std::remove_if(m_items.begin(), m_items.end(), [](const Item& item) {
+                return !std::isfinite(item.x) || !std::isfinite(item.y) || !std::isfinite(item.z);
+            }), m_items.end());
+
+            std::vector<uint64_t> keys(m_items.size());
+            std::vector<uint32_t> order(m_items.size());
+
+            m_min_cell.fill(std::numeric_limits<int32_t>::max());
+            m_max_cell.fill(std::numeric_limits<int32_t>::min());
+
+            for (uint32_t i = 0; i < m_items.size(); ++i) {
+                auto& item = m_items[i];
+                const int32_t c[3]{ cell(item.x), cell(item.y), cell(item.z) };
+
+                for (auto axis = 0; axis < 3; ++axis) {
+                    m_min_cell[axis] = std::min(m_min_cell[axis], c[axis]);
+                    m_max_cell[axis] = std::max(m_max_cell[axis], c[axis]);
+                }
+
+                keys[i] = make_key(c[0], c[1], c[2]);
+                order[i] = i;
+            }
+
+            std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+            std::vector<Item> sorted{};
+            sorted.reserve(m_items.size());
+
+            for (uint32_t i = 0; i < order.size(); ++i) {
+                const auto key = keys[order[i]];
+
+                if (i == 0 || keys[order[i - 1]] != key) {
+                    m_cells[key] = { (uint32_t)i, (uint32_t)i };
+                }
+
+                ++m_cells[key].end;
+                sorted.push_back(m_items[order[i]]);
+            }
+
+            m_items = std::move(sorted);
+        }
+
+        // Calls func(const Item&) for every item within radius of the point
+        template <typename F>
+        void query_radius(float x, float y, float z, float radius, F&& func) const {
+            if (m_items.empty() || !std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z) || !(radius >= 0.0f)) {
+                return;
+            }
+
+            const auto radius_sq = radius * radius;
+
+            const auto min_x = cell(x - radius), max_x = cell(x + radius);
+            const auto min_y = cell(y - radius), max_y = cell(y + radius);
+            const auto min_z = cell(z - radius), max_z = cell(z + radius);
+
+            // Huge radius, walking the cells would be slower than just checking everything.
+            // Counted in doubles, the box can be big enough to overflow an integer.
+            const auto num_cells = ((double)max_x - min_x + 1) * ((double)max_y - min_y + 1) * ((double)max_z - min_z + 1);
+
+            if (num_cells > (double)m_cells.size()) {
+                for (auto& item : m_items) {
+                    if (distance_sq(item, x, y, z) <= radius_sq) {
+                        func(item);
+                    }
+                }
+
+                return;
+            }
+
+            for (auto cx = min_x; cx <= max_x; ++cx) {
+                for (auto cy = min_y; cy <= max_y; ++cy) {
+                    for (auto cz = min_z; cz <= max_z; ++cz) {
+                        auto it = m_cells.find(make_key(cx, cy, cz));
+
+                        if (it == m_cells.end()) {
+                            continue;
+                        }
+
+                        for (auto i = it->second.begin; i < it->second.end; ++i) {
+                            if (distance_sq(m_items[i], x, y, z) <= radius_sq) {
+                                func(m_items[i]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Calls func(const Item&) for every item inside all 6 planes.
+        // Only walks the cells inside the box around the frustum's corners, skipping slabs of it the frustum misses.
+        template <typename F>
+        void query_frustum(const Frustum& frustum, F&& func) const {
+            if (m_items.empty()) {
+                return;
+            }
+
+            // Whole block of cells is outside of a plane
+            auto is_outside = [&](int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t z0, int32_t z1) {
+                const float min[3]{ x0 * m_cell_size, y0 * m_cell_size, z0 * m_cell_size };
+                const float max[3]{ (x1 + 1) * m_cell_size, (y1 + 1) * m_cell_size, (z1 + 1) * m_cell_size };
+
+                return !is_box_inside(frustum, min, max);
+            };
+
+            // Where the frustum could have items, clipped to where the items are
+            std::array<int32_t, 3> min_cell{ m_min_cell };
+            std::array<int32_t, 3> max_cell{ m_max_cell };
+
+            if (float min[3]{}, max[3]{}; get_frustum_bounds(frustum, min, max)) {
+                for (auto axis = 0; axis < 3; ++axis) {
+                    min_cell[axis] = std::max(min_cell[axis], cell(min[axis]));
+                    max_cell[axis] = std::min(max_cell[axis], cell(max[axis]));
+
+                    if (min_cell[axis] > max_cell[axis]) {
+                        return;
+                    }
+                }
+            }
+
+            const auto num_cells = ((double)max_cell[0] - min_cell[0] + 1) * ((double)max_cell[1] - min_cell[1] + 1) * ((double)max_cell[2] - min_cell[2] + 1);
+
+            // A cell lookup costs about as much as checking several items, when the box holds more cells
+            // than that (sparse grid, or no bounds because the far plane is at infinity) just check every item
+            if (num_cells * 8.0 > (double)m_items.size()) {
+                for (auto& item : m_items) {
+                    if (is_point_inside(frustum, item)) {
+                        func(item);
+                    }
+                }
+
+                return;
+            }
+
+            // Slabs and rows of the box that are entirely outside get skipped before looking anything up
+            for (auto cx = min_cell[0]; cx <= max_cell[0]; ++cx) {
+                if (is_outside(cx, cx, min_cell[1], max_cell[1], min_cell[2], max_cell[2])) {
+                    continue;
+                }
+
+                for (auto cy = min_cell[1]; cy <= max_cell[1]; ++cy) {
+                    if (is_outside(cx, cx, cy, cy, min_cell[2], max_cell[2])) {
+                        continue;
+                    }
+
+                    for (auto cz = min_cell[2]; cz <= max_cell[2]; ++cz) {
+                        auto it = m_cells.find(make_key(cx, cy, cz));
+
+                        if (it == m_cells.end() || is_outside(cx, cx, cy, cy, cz, cz)) {
+                            continue;
+                        }
+
+                        for (auto i = it->second.begin; i < it->second.end; ++i) {
+                            if (is_point_inside(frustum, m_items[i])) {
+                                func(m_items[i]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        size_t size() const {
+            return m_items.size();
+        }
+
+        const auto& get_items() const {
+            return m_items;
+        }
+
+    private:
+        struct Range {
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        // Clamped so the cast stays defined for anything finite, callers keep NaN out
+        int32_t cell(float v) const {
+            constexpr float limit = (float)(1 << 30);
+            return (int32_t)std::clamp(std::floor(v * m_inv_cell_size), -limit, limit);
+        }
+
+        // 21 bits per axis, plenty for any map at a few meters per cell
+        static uint64_t make_key(int32_t x, int32_t y, int32_t z) {
+            constexpr uint64_t mask = (1 << 21) - 1;
+            return (((uint64_t)x & mask) << 42) | (((uint64_t)y & mask) << 21) | ((uint64_t)z & mask);
+        }
+
+        static float distance_sq(const Item& item, float x, float y, float z) {
+            const auto dx = item.x - x;
+            const auto dy = item.y - y;
+            const auto dz = item.z - z;
+
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        static bool is_point_inside(const Frustum& frustum, const Item& item) {
+            for (auto& p : frustum) {
+                if (p[0] * item.x + p[1] * item.y + p[2] * item.z + p[3] < 0.0f) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        static bool is_box_inside(const Frustum& frustum, const float* min, const float* max) {
+            for (auto& p : frustum) {
+                // The corner furthest along the plane normal
+                const auto x = p[0] >= 0.0f ? max[0] : min[0];
+                const auto y = p[1] >= 0.0f ? max[1] : min[1];
+                const auto z = p[2] >= 0.0f ? max[2] : min[2];
+
+                if (p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0f) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // The 8 corners are where a left/right, a bottom/top and a near/far plane meet.
+        // False if that doesn't work out (planes that don't meet, infinite far plane).
+        static bool get_frustum_bounds(const Frustum& frustum, float* min, float* max) {
+            for (auto axis = 0; axis < 3; ++axis) {
+                min[axis] = std::numeric_limits<float>::max();
+                max[axis] = std::numeric_limits<float>::lowest();
+            }
+
+            auto cross = [](const Plane& a, const Plane& b) {
+                return std::array<float, 3>{ a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+            };
+
+            for (auto i = 0; i < 8; ++i) {
+                auto& p1 = frustum[0 + (i & 1)];
+                auto& p2 = frustum[2 + ((i >> 1) & 1)];
+                auto& p3 = frustum[4 + ((i >> 2) & 1)];
+
+                const auto c23 = cross(p2, p3);
+                const auto c31 = cross(p3, p1);
+                const auto c12 = cross(p1, p2);
+                const auto det = p1[0] * c23[0] + p1[1] * c23[1] + p1[2] * c23[2];
+
+                if (std::fabs(det) < 1e-12f) {
+                    return false;
+                }
+
+                for (auto axis = 0; axis < 3; ++axis) {
+                    const auto v = -(p1[3] * c23[axis] + p2[3] * c31[axis] + p3[3] * c12[axis]) / det;
+
+                    if (!std::isfinite(v)) {
+                        return false;
+                    }
+
+                    min[axis] = std::min(min[axis], v);
+                    max[axis] = std::max(max[axis], v);
+                }
+            }
+
+            return true;
+        }
+
+        float m_cell_size;
+        float m_inv_cell_size;
+
+        // Bounds of the occupied cells
+        std::array<int32_t, 3> m_min_cell{};
+        std::array<int32_t, 3> m_max_cell{};
+
+        std::vector<Item> m_items{};
+        std::unordered_map<uint64_t, Range> m_cells{};
+    };
+}
@@ -1,13 +1,23 @@
 #include <cstdarg>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <Windows.h>
 
+#include "AsciiNarrow.hpp"
 #include "String.hpp"
 
 using namespace std;
 
 namespace utility {
     string narrow(wstring_view str) {
+        if (string ascii{}; narrow_ascii(str.data(), str.length(), ascii)) {
+            return ascii;
+        }
+
         auto length = WideCharToMultiByte(CP_UTF8, 0, str.data(), (int)str.length(), nullptr, 0, nullptr, nullptr);
         string narrowStr{};
 
@@ -17,6 +27,69 @@ namespace utility {
         return narrowStr;
     }
 
+    struct InternKey {
+        const wchar_t* ptr;
+        size_t length;
+
+        bool operator==(const InternKey& other) const {
+            return ptr == other.ptr && length == other.length;
+        }
+    };
+
+    struct InternKeyHasher {
+        size_t operator()(const InternKey& key) const {
+            return std::hash<const void*>{}(key.ptr) ^ (key.length * 0x9E3779B97F4A7C15);
+        }
+    };
+
+    struct InternEntry {
+        size_t content_hash;
+        string_view str;
+    };
+
+    // Past this many (pointer, length) keys the lookup cache starts over. Freed engine strings
+    // leave their keys behind, this keeps them from piling up. The strings themselves stay.
+    static constexpr size_t MAX_INTERNED_KEYS = 0x10000;
+
+    static shared_mutex g_intern_mutex{};
+    static unordered_map<InternKey, InternEntry, InternKeyHasher> g_interned{};
+    // deque so the strings never move, every view we've handed out stays valid.
+    // Only grows with distinct contents, the same name from a new pointer reuses its copy.
+    static deque<string> g_intern_storage{};
+    static unordered_set<string_view> g_intern_strings{};
+
+    string_view narrow_interned(wstring_view str) {
+        const InternKey key{ str.data(), str.length() };
+        const auto content_hash = hash(str);
+
+        {
+            shared_lock _{ g_intern_mutex };
+
+            if (auto it = g_interned.find(key); it != g_interned.end() && it->second.content_hash == content_hash) {
+                return it->second.str;
+            }
+        }
+
+        auto narrowed = narrow(str);
+
+        unique_lock _{ g_intern_mutex };
+
+        // Same content from somewhere else, no need for another copy
+        auto it = g_intern_strings.find(narrowed);
+
+        if (it == g_intern_strings.end()) {
+            it = g_intern_strings.emplace(g_intern_storage.emplace_back(move(narrowed))).first;
+        }
+
+        if (g_interned.size() >= MAX_INTERNED_KEYS && g_interned.count(key) == 0) {
+            g_interned.clear();
+        }
+
+        g_interned[key] = { content_hash, *it };
+
+        return *it;
+    }
+
     wstring widen(string_view str) {
         auto length = MultiByteToWideChar(CP_UTF8, 0, str.data(), (int)str.length(), nullptr, 0);
         wstring wideStr{};
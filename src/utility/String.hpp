@@ -12,6 +12,11 @@ namespace utility {
     std::string narrow(std::wstring_view std);
     std::wstring widen(std::string_view std);
 
+    // narrow, but the result is cached by the source pointer and length and stays valid forever.
+    // For names that live in engine memory and get converted over and over (game objects, joints, etc).
+    // The content is re-checked on every hit, so a reused pointer doesn't hand back a stale name.
+    std::string_view narrow_interned(std::wstring_view std);
+
     std::string format_string(const char* format, va_list args);
     
     // FNV-1a
@@ -25,6 +30,17 @@ namespace utility {
 
         return result;
     }
+
+    static constexpr auto hash(std::wstring_view data) {
+        size_t result = 0xcbf29ce484222325;
+
+        for (wchar_t c : data) {
+            result ^= c;
+            result *= (size_t)1099511628211;
+        }
+
+        return result;
+    }
 }
 
 constexpr auto operator "" _fnv(const char* s, size_t) {
@@ -0,0 +1,415 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FlatMap.hpp"
+
+namespace utility {
+    // Case insensitive substring search over a fixed set of names (type names, mostly).
+    // Every 3 character window of every name is indexed, a query only has to look at
+    // the names that have its rarest window, instead of running find on every name.
+    // Single characters and pairs are indexed too, their posting lists are the answer as is.
+    // The names themselves aren't copied, they have to outlive the index (a lowercased copy is kept for checking).
+    class TrigramIndex {
+    public:
+        struct Match {
+            uint32_t id; // index into the names the index was built from
+            int32_t score;
+        };
+
+        TrigramIndex() = default;
+
+        TrigramIndex(std::vector<std::string_view> names)
+            : m_names{ std::move(names) }
+        {
+            // Every name lowercased and zero terminated, back to back, so checking and scoring a candidate
+            // doesn't lower anything. Queries can't have a zero in them, prefix checks stop at the end by themselves.
+            m_starts.reserve(m_names.size() + 1);
+            m_own_starts.reserve(m_names.size());
+
+            for (auto& name : m_names) {
+                m_starts.push_back((uint32_t)m_text.size());
+
+                const auto last_dot = name.find_last_of('.');
+                m_own_starts.push_back(last_dot != std::string_view::npos ? (uint32_t)last_dot + 1 : UINT32_MAX);
+
+                for (auto c : name) {
+                    m_text.push_back(lower(c));
+                }
+
+                m_text.push_back('\0');
+            }
+
+            m_starts.push_back((uint32_t)m_text.size());
+
+            // Ties in score go to the shorter name, then alphabetical. Worked out once so ranking only compares integers.
+            std::vector<uint32_t> order(m_names.size());
+
+            for (uint32_t id = 0; id < order.size(); ++id) {
+                order[id] = id;
+            }
+
+            std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+                const auto& a_name = m_names[a];
+                const auto& b_name = m_names[b];
+
+                return a_name.size() != b_name.size() ? a_name.size() < b_name.size() : a_name < b_name;
+            });
+
+            m_ranks.resize(m_names.size());
+
+            for (uint32_t i = 0; i < order.size(); ++i) {
+                m_ranks[order[i]] = i;
+            }
+
+            // (gram, id) pairs sorted into one flat postings array instead of a vector per gram
+            std::vector<uint64_t> pairs{};
+
+            for (uint32_t id = 0; id < m_names.size(); ++id) {
+                for (size_t length = 1; length <= 3; ++length) {
+                    for_each_gram(get_lowered(id), length, [&](uint32_t gram) {
+                        pairs.push_back(((uint64_t)gram << 32) | id);
+                    });
+                }
+            }
+
+            std::sort(pairs.begin(), pairs.end());
+            pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+            m_postings.reserve(pairs.size());
+
+            for (size_t i = 0; i < pairs.size(); ++i) {
+                const auto gram = (uint32_t)(pairs[i] >> 32);
+
+                if (i == 0 || (uint32_t)(pairs[i - 1] >> 32) != gram) {
+                    m_ranges[gram] = { (uint32_t)i, (uint32_t)i };
+                }
+
+                ++m_ranges[gram].end;
+                m_postings.push_back((uint32_t)pairs[i]);
+            }
+        }
+
+        const std::vector<std::string_view>& get_names() const {
+            return m_names;
+        }
+
+        // Every name containing query, in no particular order (see rank). candidates narrows the search
+        // to a previous result (see Search). Returns false if cancel got set partway through, out is incomplete then.
+        bool match(std::string_view query, std::vector<Match>& out, const std::vector<Match>* candidates = nullptr,
+            const std::atomic<bool>* cancel = nullptr) const
+        {
+            out.clear();
+
+            if (query.empty() || query.find('\0') != std::string_view::npos) {
+                return true;
+            }
+
+            std::string lowered{ query };
+            std::transform(lowered.begin(), lowered.end(), lowered.begin(), lower);
+
+            // The trigrams only say the pieces are there, not that they're in a row, so the rarest
+            // one is as good a starting point as intersecting all of them, and a lot cheaper.
+            // Anything shorter is a gram of its own, every name in its list matches.
+            const Range* rarest = nullptr;
+            bool missing = false;
+
+            for_each_gram(lowered, std::min<size_t>(lowered.size(), 3), [&](uint32_t gram) {
+                if (auto it = m_ranges.find(gram); it == m_ranges.end()) {
+                    missing = true;
+                }
+                else if (rarest == nullptr || it->second.end - it->second.begin < rarest->end - rarest->begin) {
+                    rarest = &it->second;
+                }
+            });
+
+            if (missing) {
+                return true;
+            }
+
+            const auto ids = m_postings.data() + rarest->begin;
+            const auto num_ids = rarest->end - rarest->begin;
+
+            // Filled by index, push_back costs more than the check for short queries
+            auto check_all = [&](size_t count, auto&& get_id, bool verify) {
+                out.resize(count);
+                size_t num_matches = 0;
+
+                for (size_t i = 0; i < count; ++i) {
+                    if (is_cancelled(cancel, i)) {
+                        out.resize(num_matches);
+                        return false;
+                    }
+
+                    const auto id = get_id(i);
+
+                    if (!verify || get_lowered(id).find(lowered) != std::string_view::npos) {
+                        out[num_matches++] = { id, score(id, lowered) };
+                    }
+                }
+
+                out.resize(num_matches);
+                return true;
+            };
+
+            // Whichever is shorter, everything that matches is in both
+            if (candidates != nullptr && candidates->size() < num_ids) {
+                return check_all(candidates->size(), [&](size_t i) { return (*candidates)[i].id; }, true);
+            }
+
+            return check_all(num_ids, [&](size_t i) { return ids[i]; }, lowered.size() > 3);
+        }
+
+        // Best max_results of matches, best first. Exact beats the start of the type's own name
+        // ("Foo" for "app.Foo") beats the start of the full name beats anywhere else, then shorter names first.
+        // Fuzzy matches score by how many trigrams they share instead.
+        void rank(const std::vector<Match>& matches, std::vector<Match>& out, size_t max_results = SIZE_MAX) const {
+            out.resize(std::min(matches.size(), max_results));
+            std::partial_sort_copy(matches.begin(), matches.end(), out.begin(), out.end(), [this](const Match& a, const Match& b) {
+                return a.score != b.score ? a.score > b.score : m_ranks[a.id] < m_ranks[b.id];
+            });
+        }
+
+        // match, then rank
+        bool find(std::string_view query, std::vector<Match>& out, size_t max_results = SIZE_MAX,
+            const std::vector<Match>* candidates = nullptr, const std::atomic<bool>* cancel = nullptr) const
+        {
+            std::vector<Match> matches{};
+
+            if (!match(query, matches, candidates, cancel)) {
+                out.clear();
+                return false;
+            }
+
+            rank(matches, out, max_results);
+            return true;
+        }
+
+        // Names sharing at least half of the query's trigrams, for typos and partial words.
+        bool find_fuzzy(std::string_view query, std::vector<Match>& out, size_t max_results = SIZE_MAX, const std::atomic<bool>* cancel = nullptr) const {
+            out.clear();
+
+            std::vector<Match> matches{};
+
+            if (!match_fuzzy(query, matches, cancel)) {
+                return false;
+            }
+
+            rank(matches, out, max_results);
+            return true;
+        }
+
+        // Search box state. Every name the last query matched is kept, not just the ones shown, so typing
+        // more characters only rechecks those. Anything else (deleting, pasting something new) goes back to the index.
+        class Search {
+        public:
+            Search(size_t max_results = SIZE_MAX)
+                : m_max_results{ max_results }
+            {
+            }
+
+            // Returns false if cancelled, the previous results are kept then.
+            bool update(const TrigramIndex& index, std::string_view query, const std::atomic<bool>* cancel = nullptr) {
+                if (query == m_query) {
+                    return true;
+                }
+
+                // Swapped with m_matches once it's done, so neither buffer is reallocated every keystroke
+                auto& matches = m_next_matches;
+
+                const auto narrows = !m_query.empty() && !m_fuzzy && contains(query, m_query);
+
+                if (!index.match(query, matches, narrows ? &m_matches : nullptr, cancel)) {
+                    return false;
+                }
+
+                auto fuzzy = false;
+
+                // Nothing matched exactly, see if anything is close
+                if (matches.empty() && query.size() >= 3) {
+                    if (!index.match_fuzzy(query, matches, cancel)) {
+                        return false;
+                    }
+
+                    fuzzy = true;
+                }
+
+                index.rank(matches, m_results, m_max_results);
+
+                m_fuzzy = fuzzy;
+                m_query = query;
+                std::swap(m_matches, matches);
+
+                return true;
+            }
+
+            // The best max_results matches, best first
+            const std::vector<Match>& get_results() const {
+                return m_results;
+            }
+
+            // How many names matched in total, including the ones cut off
+            size_t get_num_matches() const {
+                return m_matches.size();
+            }
+
+            bool is_fuzzy() const {
+                return m_fuzzy;
+            }
+
+        private:
+            size_t m_max_results;
+            std::string m_query{};
+            std::vector<Match> m_matches{};
+            std::vector<Match> m_next_matches{};
+            std::vector<Match> m_results{};
+            bool m_fuzzy{ false };
+        };
+
+    private:
+        struct Range {
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        static char lower(char c) {
+            return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+        }
+
+        // Every window of 1 to 3 characters, lowercased, with the length in the top byte so they don't collide
+        template <typename F>
+        static void for_each_gram(std::string_view s, size_t length, F&& func) {
+            for (size_t i = 0; i + length <= s.size(); ++i) {
+                auto gram = (uint32_t)length << 24;
+
+                for (size_t j = 0; j < length; ++j) {
+                    gram |= (uint32_t)(uint8_t)lower(s[i + j]) << ((length - 1 - j) * 8);
+                }
+
+                func(gram);
+            }
+        }
+
+        static size_t find_lower(std::string_view s, std::string_view needle) {
+            if (needle.size() > s.size()) {
+                return std::string_view::npos;
+            }
+
+            for (size_t i = 0; i + needle.size() <= s.size(); ++i) {
+                size_t j = 0;
+
+                while (j < needle.size() && lower(s[i + j]) == lower(needle[j])) {
+                    ++j;
+                }
+
+                if (j == needle.size()) {
+                    return i;
+                }
+            }
+
+            return std::string_view::npos;
+        }
+
+        static bool contains(std::string_view s, std::string_view needle) {
+            return find_lower(s, needle) != std::string_view::npos;
+        }
+
+        static bool is_cancelled(const std::atomic<bool>* cancel, size_t i) {
+            return cancel != nullptr && (i & 0x3FF) == 0 && cancel->load(std::memory_order_relaxed);
+        }
+
+        std::string_view get_lowered(uint32_t id) const {
+            return std::string_view{ m_text.data() + m_starts[id], m_starts[id + 1] - m_starts[id] - 1 };
+        }
+
+        // For a name that contains query (lowercased)
+        int32_t score(uint32_t id, std::string_view query) const {
+            const auto name = &m_text[m_starts[id]];
+            const auto size = m_starts[id + 1] - m_starts[id] - 1;
+
+            if (size == query.size()) {
+                return 1000;
+            }
+
+            const auto own_start = m_own_starts[id];
+
+            if (own_start != UINT32_MAX && starts_with(name + own_start, query)) {
+                return 500;
+            }
+
+            return starts_with(name, query) ? 300 : 100;
+        }
+
+        // s is zero terminated and query can't have a zero in it, so this stops at the end of s by itself
+        static bool starts_with(const char* s, std::string_view query) {
+            for (size_t i = 0; i < query.size(); ++i) {
+                if (s[i] != query[i]) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool match_fuzzy(std::string_view query, std::vector<Match>& out, const std::atomic<bool>* cancel) const {
+            out.clear();
+
+            std::vector<uint32_t> trigrams{};
+            for_each_gram(query, 3, [&](uint32_t trigram) { trigrams.push_back(trigram); });
+
+            std::sort(trigrams.begin(), trigrams.end());
+            trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+            if (trigrams.empty()) {
+                return true;
+            }
+
+            std::vector<uint16_t> counts(m_names.size());
+            std::vector<uint32_t> touched{};
+
+            for (auto trigram : trigrams) {
+                auto it = m_ranges.find(trigram);
+
+                if (it == m_ranges.end()) {
+                    continue;
+                }
+
+                for (auto i = it->second.begin; i < it->second.end; ++i) {
+                    if (is_cancelled(cancel, i)) {
+                        return false;
+                    }
+
+                    if (counts[m_postings[i]]++ == 0) {
+                        touched.push_back(m_postings[i]);
+                    }
+                }
+            }
+
+            const auto threshold = std::max<size_t>(1, (trigrams.size() + 1) / 2);
+
+            for (auto id : touched) {
+                if (counts[id] >= threshold) {
+                    out.push_back({ id, (int32_t)(counts[id] * 100 / trigrams.size()) });
+                }
+            }
+
+            return true;
+        }
+
+        std::vector<std::string_view> m_names{};
+        // Lowercased names, each followed by a zero. m_starts[id] is where a name starts, with one extra at the end.
+        std::string m_text{};
+        std::vector<uint32_t> m_starts{};
+        // Where the part after the last '.' starts, UINT32_MAX if there's no dot
+        std::vector<uint32_t> m_own_starts{};
+        // Position in (length, name) order
+        std::vector<uint32_t> m_ranks{};
+        std::vector<uint32_t> m_postings{};
+        FlatMap<uint32_t, Range> m_ranges{};
+    };
+}
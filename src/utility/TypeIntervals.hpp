@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace utility {
+    // Pre/post numbering of a forest (Euler tour), so "is A below B" turns into two integer compares
+    // instead of a walk up the parent chain. Knows nothing about the engine, RETypeHierarchy feeds it REType*s.
+    //   Node get_parent(Node);  // Node{} for roots
+    template <typename Node>
+    class TypeIntervals {
+    public:
+        TypeIntervals() = default;
+
+        // Parents don't have to be in nodes, they get pulled in.
+        template <typename GetParent>
+        TypeIntervals(const std::vector<Node>& nodes, GetParent&& get_parent) {
+            std::unordered_map<Node, std::vector<Node>> children{};
+            std::vector<Node> roots{};
+            std::unordered_set<Node> seen{};
+
+            std::vector<Node> pending{ nodes.begin(), nodes.end() };
+
+            while (!pending.empty()) {
+                auto node = pending.back();
+                pending.pop_back();
+
+                if (node == Node{} || !seen.insert(node).second) {
+                    continue;
+                }
+
+                auto parent = get_parent(node);
+
+                if (parent == Node{}) {
+                    roots.push_back(node);
+                }
+                else {
+                    children[parent].push_back(node);
+                    pending.push_back(parent);
+                }
+            }
+
+            m_intervals.reserve(seen.size());
+
+            // Iterative DFS, the chains can get deep enough that recursion isn't a great idea.
+            struct Frame {
+                Node node;
+                size_t next_child;
+            };
+
+            uint32_t counter = 0;
+            std::vector<Frame> stack{};
+
+            for (auto root : roots) {
+                stack.push_back({ root, 0 });
+                m_intervals[root].pre = counter++;
+
+                while (!stack.empty()) {
+                    auto& frame = stack.back();
+                    auto it = children.find(frame.node);
+
+                    if (it != children.end() && frame.next_child < it->second.size()) {
+                        auto child = it->second[frame.next_child++];
+
+                        m_intervals[child].pre = counter++;
+                        stack.push_back({ child, 0 });
+                        continue;
+                    }
+
+                    m_intervals[frame.node].post = counter++;
+                    stack.pop_back();
+                }
+            }
+        }
+
+        // Returns 1 if node is below (or is) base, 0 if not, -1 if either isn't in the table.
+        int32_t is_a(Node node, Node base) const {
+            auto node_it = m_intervals.find(node);
+            auto base_it = m_intervals.find(base);
+
+            if (node_it == m_intervals.end() || base_it == m_intervals.end()) {
+                return -1;
+            }
+
+            const auto& a = node_it->second;
+            const auto& b = base_it->second;
+
+            return b.pre <= a.pre && a.post <= b.post ? 1 : 0;
+        }
+
+        bool contains(Node node) const {
+            return m_intervals.count(node) > 0;
+        }
+
+        size_t size() const {
+            return m_intervals.size();
+        }
+
+        // Every node in the table, parents that got pulled in included
+        template <typename F>
+        void for_each(F&& func) const {
+            for (auto& [node, interval] : m_intervals) {
+                func(node);
+            }
+        }
+
+    private:
+        struct Interval {
+            uint32_t pre;
+            uint32_t post;
+        };
+
+        std::unordered_map<Node, Interval> m_intervals;
+    };
+}
@@ -0,0 +1,101 @@
+// utility::narrow_ascii against a character at a time reference, for 16 bit (SSE2 path) and 32 bit characters.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "utility/AsciiNarrow.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    template <typename Char>
+    bool reference(const std::vector<Char>& str, std::string& out) {
+        std::string result{};
+
+        for (auto c : str) {
+            if ((uint32_t)c >= 0x80) {
+                return false;
+            }
+
+            result.push_back((char)c);
+        }
+
+        out = result;
+        return true;
+    }
+
+    // Every length up to a few vectors, with a bad character at every position (or none),
+    // and a few that only go wrong in the high byte so a plain pack would let them through
+    template <typename Char>
+    void test_against_reference(std::mt19937& rng) {
+        std::uniform_int_distribution<uint32_t> ascii{ 0, 0x7F };
+        const std::vector<uint32_t> bad{ 0x80, 0xFF, 0x100, 0x17F, 0x141, 0x7F80, 0x8000, 0xFFFF };
+
+        for (size_t length = 0; length <= 70; ++length) {
+            for (size_t bad_at = 0; bad_at <= length; ++bad_at) {
+                for (auto bad_char : bad) {
+                    std::vector<Char> str(length);
+
+                    for (auto& c : str) {
+                        c = (Char)ascii(rng);
+                    }
+
+                    if (bad_at < length) {
+                        str[bad_at] = (Char)bad_char;
+                    }
+
+                    std::string expected{ "untouched" };
+                    std::string actual{ "untouched" };
+                    const auto expected_ok = reference(str, expected);
+                    const auto actual_ok = utility::narrow_ascii(str.data(), str.size(), actual);
+
+                    CHECK(expected_ok == actual_ok);
+                    CHECK(expected == actual);
+
+                    // Nothing bad in it, one pass is enough
+                    if (bad_at == length) {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // Doesn't read or write past the end
+    void test_unaligned(std::mt19937& rng) {
+        std::uniform_int_distribution<uint32_t> ascii{ 1, 0x7F };
+
+        std::vector<char16_t> buffer(300);
+
+        for (auto& c : buffer) {
+            c = (char16_t)ascii(rng);
+        }
+
+        for (size_t start = 0; start < 9; ++start) {
+            for (size_t length : { 15u, 16u, 17u, 31u, 32u, 33u, 250u }) {
+                // Non-ASCII right behind the end, which a read past it would trip over
+                auto guard = buffer[start + length];
+                buffer[start + length] = 0x1234;
+
+                std::string out{};
+                CHECK(utility::narrow_ascii(buffer.data() + start, length, out));
+                CHECK_EQ(out.size(), length);
+                CHECK(std::equal(out.begin(), out.end(), buffer.begin() + start, [](char a, char16_t b) { return (char16_t)a == b; }));
+
+                buffer[start + length] = guard;
+            }
+        }
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 40 };
+
+    test_against_reference<char16_t>(rng);
+    test_against_reference<wchar_t>(rng);
+    test_unaligned(rng);
+
+    return test::result();
+}
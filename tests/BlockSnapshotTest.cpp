@@ -0,0 +1,212 @@
+// utility::BlockSnapshot diffs against a byte by byte comparison, and the SSE2 block hash/diff against the scalar ones.
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "utility/BlockSnapshot.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    using utility::BlockSnapshot;
+
+    using Run = std::tuple<const void*, uint32_t, uint32_t>; // address, offset, size
+
+    void test_block_kernels(std::mt19937& rng) {
+        uint8_t a[BlockSnapshot::BLOCK_SIZE]{};
+        uint8_t b[BlockSnapshot::BLOCK_SIZE]{};
+
+        for (auto i = 0; i < 10000; ++i) {
+            for (auto& byte : a) {
+                byte = (uint8_t)rng();
+            }
+
+            // Mostly the same, a few bytes off, or nothing in common
+            memcpy(b, a, sizeof(a));
+
+            for (auto j = rng() % 4; j > 0; --j) {
+                b[rng() % sizeof(b)] ^= (uint8_t)(1 + rng() % 255);
+            }
+
+            if (i % 10 == 0) {
+                for (auto& byte : b) {
+                    byte = (uint8_t)rng();
+                }
+            }
+
+            CHECK(BlockSnapshot::hash_block(a) == BlockSnapshot::hash_block_scalar(a));
+            CHECK(BlockSnapshot::hash_block(b) == BlockSnapshot::hash_block_scalar(b));
+            CHECK(BlockSnapshot::diff_block(a, b) == BlockSnapshot::diff_block_scalar(a, b));
+
+            uint64_t expected = 0;
+
+            for (size_t j = 0; j < sizeof(a); ++j) {
+                expected |= (uint64_t)(a[j] != b[j]) << j;
+            }
+
+            CHECK(BlockSnapshot::diff_block(a, b) == expected);
+            CHECK((BlockSnapshot::hash_block(a) == BlockSnapshot::hash_block(b)) == (expected == 0));
+        }
+
+        // Every single bit flip changes the hash
+        for (auto& byte : a) {
+            byte = (uint8_t)rng();
+        }
+
+        const auto hash = BlockSnapshot::hash_block(a);
+
+        for (size_t bit = 0; bit < sizeof(a) * 8; ++bit) {
+            a[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+            CHECK(BlockSnapshot::hash_block(a) != hash);
+            a[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+        }
+    }
+
+    // Every run of differing bytes in the objects both snapshots have, in capture order
+    std::vector<Run> reference_diff(const std::vector<std::vector<uint8_t>>& now, const std::vector<std::vector<uint8_t>>& before) {
+        std::vector<Run> runs{};
+
+        for (size_t i = 0; i < now.size(); ++i) {
+            auto& object = now[i];
+            auto& old = before[i];
+
+            if (object.size() != old.size()) {
+                runs.emplace_back(object.data(), 0, (uint32_t)object.size());
+                continue;
+            }
+
+            for (uint32_t j = 0; j < object.size();) {
+                if (object[j] == old[j]) {
+                    ++j;
+                    continue;
+                }
+
+                const auto start = j;
+
+                while (j < object.size() && object[j] != old[j]) {
+                    ++j;
+                }
+
+                runs.emplace_back(object.data(), start, j - start);
+            }
+        }
+
+        std::sort(runs.begin(), runs.end());
+        return runs;
+    }
+
+    std::vector<Run> to_runs(const BlockSnapshot& snapshot, const std::vector<BlockSnapshot::Change>& changes) {
+        std::vector<Run> runs{};
+
+        for (auto& change : changes) {
+            runs.emplace_back(snapshot.get_ranges()[change.range].address, change.offset, change.size);
+        }
+
+        std::sort(runs.begin(), runs.end());
+        return runs;
+    }
+
+    void test_diff(std::mt19937& rng) {
+        constexpr size_t NUM_OBJECTS = 3000;
+
+        // Sizes all over the place, including ones that end mid block and ones smaller than a block
+        std::vector<std::vector<uint8_t>> objects(NUM_OBJECTS);
+
+        for (auto& object : objects) {
+            object.resize(1 + rng() % 700);
+
+            for (auto& byte : object) {
+                byte = (uint8_t)rng();
+            }
+        }
+
+        for (auto iteration = 0; iteration < 20; ++iteration) {
+            BlockSnapshot before{};
+
+            for (auto& object : objects) {
+                before.add(object.data(), (uint32_t)object.size());
+            }
+
+            const auto old_objects = objects;
+
+            // Runs of random length, some crossing block boundaries, some rewriting a byte with itself
+            for (auto i = 0; i < 400; ++i) {
+                auto& object = objects[rng() % NUM_OBJECTS];
+                const auto offset = rng() % object.size();
+                const auto length = 1 + rng() % 150;
+
+                for (size_t j = offset; j < object.size() && j < offset + length; ++j) {
+                    object[j] = rng() % 3 == 0 ? object[j] : (uint8_t)rng();
+                }
+            }
+
+            // Every other round the order differs, so ranges have to be matched by address
+            std::vector<size_t> order(NUM_OBJECTS);
+
+            for (size_t i = 0; i < order.size(); ++i) {
+                order[i] = i;
+            }
+
+            if (iteration % 2 == 1) {
+                std::shuffle(order.begin(), order.end(), rng);
+            }
+
+            BlockSnapshot now{};
+            now.reserve(NUM_OBJECTS, NUM_OBJECTS * 700);
+
+            for (auto i : order) {
+                now.add(objects[i].data(), (uint32_t)objects[i].size());
+            }
+
+            const auto changes = now.diff(before);
+
+            CHECK(to_runs(now, changes) == reference_diff(objects, old_objects));
+
+            // The copies are what the objects held at capture time
+            for (size_t i = 0; i < NUM_OBJECTS; i += 101) {
+                auto& range = now.get_ranges()[i];
+                auto& object = objects[order[i]];
+
+                CHECK(range.address == object.data());
+                CHECK(memcmp(now.get_data(range), object.data(), object.size()) == 0);
+            }
+        }
+    }
+
+    // Ranges only one side has are skipped, ranges that changed size are reported whole
+    void test_mismatched_ranges() {
+        std::vector<uint8_t> a(100, 1);
+        std::vector<uint8_t> b(200, 2);
+        std::vector<uint8_t> c(50, 3);
+
+        BlockSnapshot before{};
+        before.add(a.data(), 100);
+        before.add(b.data(), 200);
+
+        b[150] = 9;
+
+        BlockSnapshot now{};
+        now.add(c.data(), 50);       // new
+        now.add(b.data(), 200);
+        now.add(a.data(), 60);       // shrunk
+
+        const auto runs = to_runs(now, now.diff(before));
+        auto expected = std::vector<Run>{ { a.data(), 0, 60 }, { b.data(), 150, 1 } };
+        std::sort(expected.begin(), expected.end());
+
+        CHECK(runs == expected);
+        CHECK(before.diff(before).empty());
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 50 };
+
+    test_block_kernels(rng);
+    test_diff(rng);
+    test_mismatched_ranges();
+
+    return test::result();
+}
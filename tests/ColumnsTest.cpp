@@ -0,0 +1,156 @@
+// utility::columns on synthetic rows: serial and split fills against reading each row directly,
+// every cell read exactly once, and partial fills leaving the other rows alone.
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "utility/Columns.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    // Stand-in for a component, one member per column
+    struct Row {
+        float hp;
+        int32_t state;
+        uint8_t flag;
+        double x;
+    };
+
+    using Table = utility::columns::Table<float, int32_t, uint8_t, double>;
+
+    constexpr size_t NUM_COLUMNS = 4;
+
+    std::vector<Row> make_rows(std::mt19937& rng, size_t count) {
+        std::vector<Row> rows(count);
+
+        for (auto& row : rows) {
+            row.hp = (float)(rng() % 10000) * 0.25f;
+            row.state = (int32_t)rng();
+            row.flag = (uint8_t)rng();
+            row.x = (double)rng() / 7.0;
+        }
+
+        return rows;
+    }
+
+    // What ComponentQuery's read does, minus the engine: pick the member for the column
+    struct Reader {
+        const std::vector<Row>* rows;
+        std::unique_ptr<std::atomic<uint32_t>[]> reads;
+
+        Reader(const std::vector<Row>& rows)
+            : rows{ &rows },
+            reads{ new std::atomic<uint32_t>[rows.size() * NUM_COLUMNS]{} }
+        {
+        }
+
+        template <size_t I>
+        auto operator()(size_t row, std::integral_constant<size_t, I>) {
+            ++reads[row * NUM_COLUMNS + I];
+
+            auto& r = (*rows)[row];
+
+            if constexpr (I == 0) {
+                return r.hp;
+            }
+            else if constexpr (I == 1) {
+                return r.state;
+            }
+            else if constexpr (I == 2) {
+                return r.flag;
+            }
+            else {
+                return r.x;
+            }
+        }
+
+        bool read_once(size_t begin, size_t end) const {
+            for (auto i = begin * NUM_COLUMNS; i < end * NUM_COLUMNS; ++i) {
+                if (reads[i] != 1) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    bool matches(const Table& table, const std::vector<Row>& rows, size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            if (std::get<0>(table)[i] != rows[i].hp || std::get<1>(table)[i] != rows[i].state
+                || std::get<2>(table)[i] != rows[i].flag || std::get<3>(table)[i] != rows[i].x)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void test_split_fills(std::mt19937& rng) {
+        for (size_t num_rows : { 0, 1, 2, 5, 255, 256, 1000, 4099, 20011 }) {
+            const auto rows = make_rows(rng, num_rows);
+
+            // 0 and 1 are the serial path, the rest split, including more threads than rows
+            for (size_t num_threads : { 0, 1, 2, 3, 7, 16, 64 }) {
+                Table table{};
+                Reader reader{ rows };
+
+                utility::columns::fill_split(table, num_rows, num_threads, reader);
+
+                CHECK_EQ(std::get<0>(table).size(), num_rows);
+                CHECK_EQ(std::get<3>(table).size(), num_rows);
+                CHECK(matches(table, rows, 0, num_rows));
+                CHECK(reader.read_once(0, num_rows));
+            }
+        }
+
+        // Refilling a table that held more rows shrinks it
+        Table table{};
+        auto rows = make_rows(rng, 3000);
+        Reader big{ rows };
+        utility::columns::fill_split(table, rows.size(), 4, big);
+
+        rows.resize(100);
+        Reader small{ rows };
+        utility::columns::fill_split(table, rows.size(), 4, small);
+
+        CHECK_EQ(std::get<1>(table).size(), 100);
+        CHECK(matches(table, rows, 0, rows.size()));
+    }
+
+    void test_partial_fill(std::mt19937& rng) {
+        const auto rows = make_rows(rng, 1000);
+
+        Table table{};
+        std::get<0>(table).assign(rows.size(), -1.0f);
+        std::get<1>(table).assign(rows.size(), -1);
+        std::get<2>(table).assign(rows.size(), 0xFF);
+        std::get<3>(table).assign(rows.size(), -1.0);
+
+        Reader reader{ rows };
+        utility::columns::fill(table, 300, 700, reader);
+
+        CHECK(matches(table, rows, 300, 700));
+        CHECK(reader.read_once(300, 700));
+
+        for (size_t i = 0; i < rows.size(); ++i) {
+            if (i < 300 || i >= 700) {
+                CHECK(std::get<0>(table)[i] == -1.0f && std::get<1>(table)[i] == -1);
+                CHECK(reader.reads[i * NUM_COLUMNS] == 0);
+            }
+        }
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 38 };
+
+    test_split_fills(rng);
+    test_partial_fill(rng);
+
+    return test::result();
+}
@@ -0,0 +1,167 @@
+// first_person::record_controller on stand-in camera types: what it records and restores, then
+// the controller callback racing update_camera_transform's stores and loads through a SeqLock.
+
+#include <atomic>
+#include <random>
+#include <thread>
+
+#include "utility/SeqLock.hpp"
+#include "FirstPersonState.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    struct Vec3 {
+        float x, y, z;
+    };
+
+    struct Vec4 {
+        float x, y, z, w;
+    };
+
+    struct Quat {
+        float x, y, z, w;
+    };
+
+    // Same shapes as FirstPerson::ControllerState and the bits of RopewayPlayerCameraController it touches
+    struct State {
+        Vec4 position;
+        Quat rotation;
+        Vec3 angles;
+    };
+
+    struct Controller {
+        Vec4 worldPosition;
+        Vec4 worldRotation;
+        float pitch;
+        float yaw;
+    };
+
+    Vec4 splat(float v) {
+        return Vec4{ v, v, v, v };
+    }
+
+    bool uniform(const Vec4& v) {
+        return v.x == v.y && v.y == v.z && v.z == v.w;
+    }
+
+    bool uniform(const Quat& q) {
+        return q.x == q.y && q.y == q.z && q.z == q.w;
+    }
+
+    Controller make_controller(float v) {
+        return Controller{ splat(v), splat(v), v, v };
+    }
+
+    State make_state(float v) {
+        return State{ splat(v), Quat{ v, v, v, v }, Vec3{ v, v, 0.0f } };
+    }
+
+    void test_known_values() {
+        const auto saved = State{ splat(1.0f), Quat{ 2.0f, 2.0f, 2.0f, 2.0f }, Vec3{ 3.0f, 4.0f, 0.0f } };
+
+        // Player camera, nothing to restore: everything comes from the controller
+        auto controller = make_controller(5.0f);
+        auto state = first_person::record_controller(saved, controller, true, false);
+
+        CHECK(state.position.x == 5.0f && state.rotation.w == 5.0f);
+        CHECK(state.angles.x == 5.0f && state.angles.y == 5.0f && state.angles.z == 0.0f);
+        CHECK(controller.pitch == 5.0f && controller.worldRotation.x == 5.0f);
+
+        // Restoring puts the saved rotation and angles on the controller and records them back
+        controller = make_controller(5.0f);
+        state = first_person::record_controller(saved, controller, true, true);
+
+        CHECK(controller.worldRotation.x == 2.0f && controller.worldRotation.w == 2.0f);
+        CHECK(controller.pitch == 3.0f && controller.yaw == 4.0f);
+        CHECK(controller.worldPosition.x == 5.0f);
+        CHECK(state.position.x == 5.0f && state.rotation.x == 2.0f);
+        CHECK(state.angles.x == 3.0f && state.angles.y == 4.0f);
+
+        // Other cameras don't touch the angles, restore or not
+        for (auto restore : { false, true }) {
+            controller = make_controller(5.0f);
+            state = first_person::record_controller(saved, controller, false, restore);
+
+            CHECK(state.position.x == 5.0f && state.rotation.x == 5.0f);
+            CHECK(state.angles.x == 3.0f && state.angles.y == 4.0f);
+            CHECK(controller.pitch == 5.0f && controller.worldRotation.x == 5.0f);
+        }
+    }
+
+    // Every state that gets published has rotation and angles from the same place, whether that's
+    // a store (camera transform) or a controller recording with the player camera. If restoring read
+    // them from two different states, or a load caught a write halfway, the pair wouldn't match.
+    bool consistent(const State& state) {
+        return uniform(state.position) && uniform(state.rotation)
+            && state.rotation.x == state.angles.x && state.angles.x == state.angles.y && state.angles.z == 0.0f;
+    }
+
+    void test_callbacks_racing(std::mt19937& rng) {
+        constexpr int ITERATIONS = 200000;
+
+        utility::SeqLock<State> controller_state{};
+        std::atomic<size_t> bad_states{ 0 };
+        std::atomic<size_t> bad_restores{ 0 };
+        std::atomic<size_t> restores{ 0 };
+
+        const auto seed = rng();
+
+        // on_update_camera_controller2, the game hands it a controller with fresh input every frame
+        std::thread controller_thread{ [&]() {
+            std::mt19937 local_rng{ seed };
+
+            for (int n = 1; n <= ITERATIONS; ++n) {
+                auto controller = make_controller((float)n);
+                const auto restore = local_rng() % 3 == 0;
+
+                controller_state.update([&](const State& state) {
+                    if (!consistent(state)) {
+                        ++bad_states;
+                    }
+
+                    return first_person::record_controller(state, controller, true, restore);
+                });
+
+                if (restore) {
+                    ++restores;
+
+                    if (!uniform(controller.worldRotation) || controller.worldRotation.x != controller.pitch || controller.pitch != controller.yaw) {
+                        ++bad_restores;
+                    }
+                }
+            }
+        } };
+
+        // update_camera_transform: snapshot at the top, replace the whole thing when not in control
+        std::thread camera_thread{ [&]() {
+            for (int n = 1; n <= ITERATIONS; ++n) {
+                if (!consistent(controller_state.load())) {
+                    ++bad_states;
+                }
+
+                if (n % 2 == 0) {
+                    controller_state.store(make_state(-(float)n));
+                }
+            }
+        } };
+
+        controller_thread.join();
+        camera_thread.join();
+
+        std::printf("callbacks: %d iterations each, %zu restores\n", ITERATIONS, restores.load());
+
+        CHECK(consistent(controller_state.load()));
+        CHECK_EQ(bad_states.load(), 0);
+        CHECK_EQ(bad_restores.load(), 0);
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 35 };
+
+    test_known_values();
+    test_callbacks_racing(rng);
+
+    return test::result();
+}
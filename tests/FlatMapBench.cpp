@@ -0,0 +1,115 @@
+// utility::FlatMap against std::unordered_map: insert, lookups that hit and miss, and erase,
+// for pointer keys (what most registries use) and short string keys.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utility/FlatMap.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    struct Times {
+        double insert;
+        double hit;
+        double miss;
+        double erase;
+    };
+
+    // keys are inserted, misses are looked up but never inserted
+    template <typename Map, typename K>
+    Times run(const std::vector<K>& keys, const std::vector<K>& misses, std::mt19937& rng, size_t& sink) {
+        auto shuffled = keys;
+        std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+        Map map{};
+        Times times{};
+
+        times.insert = test::time([&]() {
+            for (size_t i = 0; i < keys.size(); ++i) {
+                map[keys[i]] = (uint32_t)i;
+            }
+        });
+
+        times.hit = test::time([&]() {
+            for (auto& key : shuffled) {
+                sink += map.find(key)->second;
+            }
+        });
+
+        times.miss = test::time([&]() {
+            for (auto& key : misses) {
+                sink += map.count(key);
+            }
+        });
+
+        times.erase = test::time([&]() {
+            for (auto& key : shuffled) {
+                sink += map.erase(key);
+            }
+        });
+
+        return times;
+    }
+
+    template <typename K>
+    void compare(const char* name, const std::vector<K>& keys, const std::vector<K>& misses, std::mt19937& rng, size_t& sink) {
+        const auto flat = run<utility::FlatMap<K, uint32_t>>(keys, misses, rng, sink);
+        const auto std_map = run<std::unordered_map<K, uint32_t>>(keys, misses, rng, sink);
+
+        // ns per operation, flat / std
+        const auto ns = [&](double ms) { return ms * 1e6 / keys.size(); };
+
+        std::printf("%-8s %8zu %8.1f/%-8.1f %8.1f/%-8.1f %8.1f/%-8.1f %8.1f/%-8.1f\n", name, keys.size(),
+            ns(flat.insert), ns(std_map.insert),
+            ns(flat.hit), ns(std_map.hit),
+            ns(flat.miss), ns(std_map.miss),
+            ns(flat.erase), ns(std_map.erase));
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 42 };
+    size_t sink = 0;
+
+    std::printf("ns per op, FlatMap/std::unordered_map\n");
+    std::printf("%-8s %8s %17s %17s %17s %17s\n", "keys", "count", "insert", "hit", "miss", "erase");
+
+    for (size_t count : { 1000, 10000, 100000, 1000000 }) {
+        // Heap-like addresses, 16 byte aligned
+        std::vector<const void*> pointers{};
+        std::vector<const void*> pointer_misses{};
+        std::uniform_int_distribution<uint64_t> address{ 0x10000000000 >> 4, 0x20000000000 >> 4 };
+
+        while (pointers.size() < count) {
+            pointers.push_back((const void*)(uintptr_t)(address(rng) << 4));
+        }
+
+        std::sort(pointers.begin(), pointers.end());
+        pointers.erase(std::unique(pointers.begin(), pointers.end()), pointers.end());
+
+        for (size_t i = 0; i < count; ++i) {
+            pointer_misses.push_back((const void*)((uintptr_t)pointers[i] + 8));
+        }
+
+        compare("pointer", pointers, pointer_misses, rng, sink);
+
+        // Names like the ones components and joints have
+        std::vector<std::string> names{};
+        std::vector<std::string> name_misses{};
+
+        for (size_t i = 0; i < count; ++i) {
+            names.push_back("app.ropeway.Component" + std::to_string(i));
+            name_misses.push_back("app.ropeway.Missing" + std::to_string(i));
+        }
+
+        compare("string", names, name_misses, rng, sink);
+    }
+
+    std::printf("(%zu)\n", sink);
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+// utility::FlatMap against std::unordered_map under random inserts and erases,
+// with hashers that pile keys into long clusters and wrap them around the end of the table.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utility/FlatMap.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    // Few distinct hashes, so whole runs of slots share a home and erase has to shift them
+    struct ClusterHash {
+        size_t operator()(uint32_t key) const {
+            return (key % 5) * 3 + 1;
+        }
+    };
+
+    // Homes in the last few slots whatever the capacity, every cluster wraps to the front
+    struct WrapHash {
+        size_t operator()(uint32_t key) const {
+            return ~(size_t)(key % 4);
+        }
+    };
+
+    template <typename Map>
+    void check_same(const Map& map, const std::unordered_map<uint32_t, uint32_t>& reference, uint32_t key_range) {
+        CHECK_EQ(map.size(), reference.size());
+
+        size_t iterated = 0;
+
+        for (auto& [key, value] : map) {
+            auto it = reference.find(key);
+            CHECK(it != reference.end() && it->second == value);
+            ++iterated;
+        }
+
+        CHECK_EQ(iterated, reference.size());
+
+        for (uint32_t key = 0; key < key_range; ++key) {
+            auto it = map.find(key);
+            auto ref = reference.find(key);
+
+            CHECK((it == map.end()) == (ref == reference.end()));
+            CHECK_EQ(map.count(key), reference.count(key));
+
+            if (it != map.end() && ref != reference.end()) {
+                CHECK_EQ(it->second, ref->second);
+            }
+        }
+    }
+
+    template <typename Hash>
+    void test_random_ops(std::mt19937& rng, uint32_t key_range, size_t num_ops) {
+        utility::FlatMap<uint32_t, uint32_t, Hash> map{};
+        std::unordered_map<uint32_t, uint32_t> reference{};
+
+        std::uniform_int_distribution<uint32_t> key_dist{ 0, key_range - 1 };
+        std::uniform_int_distribution<int> op_dist{ 0, 99 };
+
+        for (size_t i = 0; i < num_ops; ++i) {
+            const auto key = key_dist(rng);
+            const auto op = op_dist(rng);
+
+            // Insert a bit more often than erase so the table fills up, then drains in phases
+            const auto erase_bias = (i / 2000) % 2 == 0 ? 40 : 65;
+
+            if (op < erase_bias) {
+                CHECK_EQ(map.erase(key), reference.erase(key));
+            }
+            else if (op < 90) {
+                const auto [it, inserted] = map.try_emplace(key, (uint32_t)i);
+                const auto [ref_it, ref_inserted] = reference.try_emplace(key, (uint32_t)i);
+
+                CHECK(inserted == ref_inserted);
+                CHECK_EQ(it->second, ref_it->second);
+            }
+            else {
+                map.insert_or_assign(key, (uint32_t)i);
+                reference.insert_or_assign(key, (uint32_t)i);
+            }
+
+            if (i % 97 == 0) {
+                check_same(map, reference, key_range);
+            }
+        }
+
+        check_same(map, reference, key_range);
+
+        // Drain it completely, checking what's left along the way
+        std::vector<uint32_t> keys{};
+
+        for (auto& [key, value] : reference) {
+            keys.push_back(key);
+        }
+
+        std::shuffle(keys.begin(), keys.end(), rng);
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+            CHECK_EQ(map.erase(keys[i]), 1);
+            CHECK_EQ(map.erase(keys[i]), 0);
+            reference.erase(keys[i]);
+
+            if (i % 31 == 0) {
+                check_same(map, reference, key_range);
+            }
+        }
+
+        CHECK(map.empty());
+        CHECK(map.begin() == map.end());
+    }
+
+    // Keys are only ever found through their own hash, and string types are interchangeable
+    void test_heterogeneous() {
+        utility::FlatMap<std::string, int> map{};
+
+        for (int i = 0; i < 1000; ++i) {
+            map[std::to_string(i)] = i;
+        }
+
+        for (int i = 0; i < 1000; i += 2) {
+            CHECK_EQ(map.erase(std::string_view{ std::to_string(i) }), 1);
+        }
+
+        for (int i = 0; i < 1000; ++i) {
+            const auto key = std::to_string(i);
+            auto it = map.find(key.c_str(), utility::FlatHash{}(key.c_str()));
+
+            CHECK((it != map.end()) == (i % 2 == 1));
+            CHECK_EQ(map.count(std::string_view{ key }), i % 2);
+        }
+
+        utility::FlatSet<const void*> set{};
+        std::vector<int> storage(100);
+
+        for (auto& v : storage) {
+            CHECK(set.insert(&v));
+            CHECK(!set.insert(&v));
+        }
+
+        for (size_t i = 0; i < storage.size(); i += 3) {
+            CHECK_EQ(set.erase(&storage[i]), 1);
+        }
+
+        size_t num_left = 0;
+        set.for_each([&](const void*) { ++num_left; });
+
+        CHECK_EQ(num_left, set.size());
+        CHECK_EQ(set.size(), 66);
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 42 };
+
+    test_random_ops<utility::FlatHash>(rng, 3000, 60000);
+    test_random_ops<ClusterHash>(rng, 300, 20000);
+    test_random_ops<WrapHash>(rng, 300, 20000);
+    test_heterogeneous();
+
+    return test::result();
+}
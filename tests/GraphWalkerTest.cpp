@@ -0,0 +1,288 @@
+// utility::GraphWalker on synthetic heaps: a small hand-made one with known answers,
+// then random ones (cycles, shared subgraphs, a root listed twice) against a brute force walk.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "utility/GraphWalker.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    // Nodes are 1-based indices into objects, 0 is "no reference"
+    struct Object {
+        uint32_t type;
+        uint32_t size;
+        std::vector<uint32_t> refs;
+    };
+
+    struct Heap {
+        using Node = uint32_t;
+        using Type = uint32_t;
+        using Edge = uint32_t; // index into refs
+
+        const std::vector<Object>* objects;
+
+        Type get_type(Node node) const {
+            return get(node).type;
+        }
+
+        size_t get_size(Node node) const {
+            return get(node).size;
+        }
+
+        template <typename F>
+        void for_each_ref(Node node, F&& func) const {
+            auto& refs = get(node).refs;
+
+            for (uint32_t i = 0; i < refs.size(); ++i) {
+                func(refs[i], i);
+            }
+        }
+
+        const Object& get(Node node) const {
+            return (*objects)[node - 1];
+        }
+    };
+
+    using Walker = utility::GraphWalker<Heap>;
+
+    // The path starts at a root, every step is reachable from the one before through its edge
+    void check_path(const Walker& walker, const std::vector<Object>& objects, uint32_t node) {
+        const auto path = walker.get_path(node);
+
+        CHECK(!path.empty());
+
+        if (path.empty()) {
+            return;
+        }
+
+        CHECK(path.back().node == node);
+
+        auto& roots = walker.get_roots();
+        CHECK(std::find(roots.begin(), roots.end(), path.front().node) != roots.end());
+
+        for (size_t i = 1; i < path.size(); ++i) {
+            auto& refs = objects[path[i - 1].node - 1].refs;
+
+            CHECK(path[i].edge < refs.size());
+            CHECK(path[i].edge < refs.size() && refs[path[i].edge] == path[i].node);
+        }
+    }
+
+    //   root 0: 1 -> 2 -> 3 -> 1 (cycle), 3 -> 4
+    //   root 1: 5 -> 6 -> 4, 6 -> 6
+    //   shared: 4 -> 7 -> 4
+    // Node n weighs n * 10
+    void test_known_graph() {
+        std::vector<Object> objects{
+            { 1, 10, { 2 } },
+            { 1, 20, { 3, 0 } },
+            { 2, 30, { 1, 4 } },
+            { 3, 40, { 7 } },
+            { 2, 50, { 6 } },
+            { 1, 60, { 6, 4 } },
+            { 3, 70, { 4 } },
+            { 9, 80, {} }, // unreachable
+        };
+
+        for (size_t num_threads : { 1, 4 }) {
+            Walker walker{ Heap{ &objects }, num_threads };
+            walker.walk({ 1, 5 });
+
+            CHECK_EQ(walker.get_total_stats().count, 7);
+            CHECK_EQ(walker.get_total_stats().size, 280);
+
+            CHECK_EQ(walker.get_root_stats()[0].count, 3);
+            CHECK_EQ(walker.get_root_stats()[0].size, 60);
+            CHECK_EQ(walker.get_root_stats()[1].count, 2);
+            CHECK_EQ(walker.get_root_stats()[1].size, 110);
+
+            CHECK_EQ(walker.get_shared_stats().count, 2);
+            CHECK_EQ(walker.get_shared_stats().size, 110);
+
+            auto& types = walker.get_type_stats();
+            CHECK_EQ(types.find(1u)->second.count, 3);
+            CHECK_EQ(types.find(1u)->second.size, 90);
+            CHECK_EQ(types.find(2u)->second.size, 80);
+            CHECK_EQ(types.find(3u)->second.size, 110);
+            CHECK(types.find(9u) == types.end());
+
+            CHECK(!walker.contains(8));
+            CHECK(walker.get_path(8).empty());
+
+            for (uint32_t node = 1; node <= 7; ++node) {
+                CHECK(walker.contains(node));
+                check_path(walker, objects, node);
+            }
+
+            // Only one way to each of these
+            const auto path = walker.get_path(3);
+            CHECK_EQ(path.size(), 3);
+            CHECK(path.size() == 3 && path[0].node == 1 && path[1].node == 2 && path[2].node == 3);
+            CHECK(path.size() == 3 && path[1].edge == 0 && path[2].edge == 0);
+
+            CHECK_EQ(walker.get_path(1).size(), 1);
+            CHECK_EQ(walker.get_path(6).size(), 2);
+        }
+    }
+
+    struct Expected {
+        size_t total_count{ 0 };
+        size_t total_size{ 0 };
+        size_t shared_count{ 0 };
+        size_t shared_size{ 0 };
+        std::vector<size_t> root_sizes{};
+        std::vector<size_t> root_counts{};
+        std::vector<uint8_t> reached{};
+    };
+
+    // Walk from every root separately, whatever more than one root reaches is shared
+    Expected brute_force(const std::vector<Object>& objects, const std::vector<uint32_t>& roots) {
+        Expected expected{};
+        expected.root_sizes.resize(roots.size());
+        expected.root_counts.resize(roots.size());
+
+        std::vector<uint32_t> num_roots(objects.size() + 1);
+        std::vector<uint32_t> only_root(objects.size() + 1);
+
+        for (uint32_t r = 0; r < roots.size(); ++r) {
+            std::vector<uint8_t> seen(objects.size() + 1);
+            std::vector<uint32_t> stack{ roots[r] };
+
+            while (!stack.empty()) {
+                const auto node = stack.back();
+                stack.pop_back();
+
+                if (node == 0 || seen[node]) {
+                    continue;
+                }
+
+                seen[node] = 1;
+                ++num_roots[node];
+                only_root[node] = r;
+
+                for (auto ref : objects[node - 1].refs) {
+                    stack.push_back(ref);
+                }
+            }
+        }
+
+        expected.reached.resize(objects.size() + 1);
+
+        for (uint32_t node = 1; node <= objects.size(); ++node) {
+            if (num_roots[node] == 0) {
+                continue;
+            }
+
+            const auto size = objects[node - 1].size;
+
+            expected.reached[node] = 1;
+            ++expected.total_count;
+            expected.total_size += size;
+
+            if (num_roots[node] > 1) {
+                ++expected.shared_count;
+                expected.shared_size += size;
+            }
+            else {
+                ++expected.root_counts[only_root[node]];
+                expected.root_sizes[only_root[node]] += size;
+            }
+        }
+
+        return expected;
+    }
+
+    void test_random_heaps(std::mt19937& rng) {
+        for (uint32_t iteration = 0; iteration < 24; ++iteration) {
+            const uint32_t num_objects = 2000 + iteration * 500;
+            std::vector<Object> objects(num_objects);
+
+            constexpr uint32_t NUM_ROOTS = 12;
+            const auto region_size = num_objects / NUM_ROOTS;
+
+            std::uniform_int_distribution<uint32_t> node_dist{ 1, num_objects };
+            std::uniform_int_distribution<uint32_t> region_dist{ 0, region_size - 1 };
+
+            // Each root gets a region that mostly points into itself, with the odd reference into
+            // another one, so roots keep a good part of their region and still run into each other
+            for (uint32_t i = 0; i < num_objects; ++i) {
+                auto& object = objects[i];
+                const auto region_start = std::min(i / region_size, NUM_ROOTS - 1) * region_size + 1;
+
+                object.type = rng() % 40;
+                object.size = 8 + rng() % 120;
+
+                const auto num_refs = rng() % 4;
+
+                for (uint32_t j = 0; j < num_refs; ++j) {
+                    const auto kind = rng() % 40;
+                    object.refs.push_back(kind < 6 ? 0 : kind == 6 ? node_dist(rng) : region_start + region_dist(rng));
+                }
+            }
+
+            std::vector<uint32_t> roots{};
+
+            for (uint32_t i = 0; i < NUM_ROOTS; ++i) {
+                roots.push_back(i * region_size + 1 + region_dist(rng));
+            }
+
+            // The same object twice counts as shared between them
+            roots.push_back(roots[iteration % roots.size()]);
+
+            Walker walker{ Heap{ &objects }, 1 + iteration % 8 };
+            walker.walk(roots);
+
+            const auto expected = brute_force(objects, roots);
+
+            CHECK_EQ(walker.get_total_stats().count, expected.total_count);
+            CHECK_EQ(walker.get_total_stats().size, expected.total_size);
+            CHECK_EQ(walker.get_shared_stats().count, expected.shared_count);
+            CHECK_EQ(walker.get_shared_stats().size, expected.shared_size);
+
+            for (size_t r = 0; r < roots.size(); ++r) {
+                CHECK_EQ(walker.get_root_stats()[r].count, expected.root_counts[r]);
+                CHECK_EQ(walker.get_root_stats()[r].size, expected.root_sizes[r]);
+            }
+
+            size_t num_nodes = 0;
+            walker.for_each_node([&](uint32_t node) {
+                CHECK(expected.reached[node]);
+                ++num_nodes;
+            });
+
+            CHECK_EQ(num_nodes, expected.total_count);
+
+            size_t type_count = 0;
+
+            for (auto& [t, stats] : walker.get_type_stats()) {
+                type_count += stats.count;
+                CHECK_EQ(objects[stats.sample - 1].type, t);
+                check_path(walker, objects, stats.sample);
+            }
+
+            CHECK_EQ(type_count, expected.total_count);
+
+            // Some paths to arbitrary reached nodes too
+            for (uint32_t node = 1; node <= num_objects; node += 97) {
+                if (expected.reached[node]) {
+                    check_path(walker, objects, node);
+                }
+                else {
+                    CHECK(walker.get_path(node).empty());
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 49 };
+
+    test_known_graph();
+    test_random_heaps(rng);
+
+    return test::result();
+}
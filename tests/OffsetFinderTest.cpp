@@ -0,0 +1,189 @@
+// utility::OffsetFinder on synthetic objects and getters, plus how the pattern search
+// compares to the old byte at a time search.
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "utility/OffsetFinder.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    constexpr size_t HEADER_SIZE = 0x10;
+
+    struct Target {
+        int32_t value;
+    };
+
+    Target g_target{ 1234 };
+    Target g_other{ 5678 };
+    Target g_stand_in{ 0 };
+
+    bool is_pointer(uintptr_t value) {
+        return value == (uintptr_t)&g_target || value == (uintptr_t)&g_other || value == (uintptr_t)&g_stand_in;
+    }
+
+    // Getters that go through a pointer in the object crash (here: count it and fail) if it's been clobbered
+    struct Getters {
+        size_t calls{ 0 };
+        size_t wild_reads{ 0 };
+
+        // Copies width bytes at offset, after making sure the owner pointer at 0x10 is still sane
+        auto copy(size_t offset, size_t width) {
+            return [this, offset, width](uint8_t* obj, uint8_t* out) {
+                ++calls;
+
+                uintptr_t owner{};
+                memcpy(&owner, obj + 0x10, sizeof(owner));
+
+                if (!is_pointer(owner)) {
+                    ++wild_reads;
+                    return false;
+                }
+
+                memcpy(out, obj + offset, width);
+                return true;
+            };
+        }
+
+        auto normalized_bool(size_t offset) {
+            return [this, offset](uint8_t* obj, uint8_t* out) {
+                ++calls;
+                out[0] = obj[offset] != 0;
+                return true;
+            };
+        }
+
+        auto follow(size_t offset) {
+            return [this, offset](uint8_t* obj, uint8_t* out) {
+                ++calls;
+
+                uintptr_t ptr{};
+                memcpy(&ptr, obj + offset, sizeof(ptr));
+
+                if (!is_pointer(ptr)) {
+                    ++wild_reads;
+                    return false;
+                }
+
+                memcpy(out, &((Target*)ptr)->value, sizeof(int32_t));
+                return true;
+            };
+        }
+    };
+
+    template <typename T>
+    void put(std::vector<uint8_t>& obj, size_t offset, const T& value) {
+        memcpy(obj.data() + offset, &value, sizeof(T));
+    }
+
+    void test_layout() {
+        std::vector<uint8_t> obj(0x80);
+
+        put(obj, 0x10, &g_target);
+        put(obj, 0x18, (int32_t)100);
+        put(obj, 0x1C, 1.5f);
+        put(obj, 0x20, (uint8_t)1);
+        put(obj, 0x22, (uint16_t)777);
+        put(obj, 0x28, (int64_t)0x1122334455667788);
+        const float vec[3]{ 1.0f, 2.0f, 3.0f };
+        put(obj, 0x30, vec);
+        put(obj, 0x40, &g_other);
+        put(obj, 0x48, (int32_t)42);
+
+        utility::OffsetFinder finder{ obj.data(), obj.size(), HEADER_SIZE, is_pointer };
+        Getters getters{};
+
+        // Pointers keep their values in the pattern
+        CHECK(memcmp(finder.get_pattern().data() + 0x10, obj.data() + 0x10, sizeof(void*)) == 0);
+        CHECK(memcmp(finder.get_pattern().data() + 0x40, obj.data() + 0x40, sizeof(void*)) == 0);
+        CHECK(memcmp(finder.get_pattern().data() + 0x18, obj.data() + 0x18, sizeof(void*)) != 0);
+
+        CHECK_EQ(finder.find(getters.copy(0x18, 4)), 0x18);
+        CHECK_EQ(finder.find(getters.copy(0x1C, 4)), 0x1C);
+        CHECK_EQ(finder.find(getters.copy(0x22, 2)), 0x22);
+        CHECK_EQ(finder.find(getters.copy(0x28, 8)), 0x28);
+        CHECK_EQ(finder.find(getters.copy(0x30, 12)), 0x30);
+        CHECK_EQ(finder.find(getters.copy(0x48, 4)), 0x48);
+
+        // Can't be patterned, the bytewise search still gets it
+        CHECK_EQ(finder.find(getters.normalized_bool(0x20)), 0);
+        CHECK_EQ(finder.find_bytewise(getters.normalized_bool(0x20)), 0x20);
+
+        // References
+        CHECK_EQ(finder.find_pointer(getters.copy(0x40, sizeof(void*)), (uintptr_t)&g_stand_in), 0x40);
+        CHECK_EQ(finder.find_pointer(getters.copy(0x10, sizeof(void*)), (uintptr_t)&g_stand_in), 0x10);
+
+        // Reads through a pointer, nothing in the object to find but it mustn't blow up either
+        CHECK_EQ(finder.find(getters.follow(0x40)), 0);
+        CHECK_EQ(finder.find_bytewise(getters.follow(0x40)), 0);
+
+        CHECK_EQ(getters.wild_reads, 0);
+
+        // And nothing was left behind
+        utility::OffsetFinder again{ obj.data(), obj.size(), HEADER_SIZE, is_pointer };
+        CHECK(finder.get_pattern() == again.get_pattern());
+        CHECK_EQ(finder.find_bytewise(getters.copy(0x48, 4)), 0x48);
+    }
+
+    // A big object with lots of int fields, every field looked up both ways
+    void compare_to_bytewise() {
+        constexpr size_t SIZE = 0x1000;
+        constexpr size_t NUM_FIELDS = 200;
+
+        std::mt19937 rng{ 1234 };
+        std::vector<uint8_t> obj(SIZE);
+
+        for (auto& b : obj) {
+            b = (uint8_t)(rng() % 4 == 0 ? rng() : 0);
+        }
+
+        put(obj, 0x10, &g_target);
+
+        std::vector<size_t> offsets{};
+
+        for (size_t i = 0; i < NUM_FIELDS; ++i) {
+            const auto offset = 0x18 + i * 0x14;
+            put(obj, offset, (int32_t)(rng() | 1));
+            offsets.push_back(offset);
+        }
+
+        Getters pattern_getters{};
+        Getters bytewise_getters{};
+        size_t pattern_found = 0;
+        size_t bytewise_found = 0;
+
+        const auto pattern_ms = test::time([&]() {
+            utility::OffsetFinder finder{ obj.data(), obj.size(), HEADER_SIZE, is_pointer };
+
+            for (auto offset : offsets) {
+                pattern_found += finder.find(pattern_getters.copy(offset, 4)) == (int32_t)offset;
+            }
+        });
+
+        const auto bytewise_ms = test::time([&]() {
+            utility::OffsetFinder finder{ obj.data(), obj.size(), HEADER_SIZE, is_pointer };
+
+            for (auto offset : offsets) {
+                bytewise_found += finder.find_bytewise(bytewise_getters.copy(offset, 4)) == (int32_t)offset;
+            }
+        });
+
+        std::printf("%zu fields in a 0x%zX byte object:\n", NUM_FIELDS, SIZE);
+        std::printf("  pattern:  %zu found, %zu getter calls, %.3fms\n", pattern_found, pattern_getters.calls, pattern_ms);
+        std::printf("  bytewise: %zu found, %zu getter calls, %.3fms\n", bytewise_found, bytewise_getters.calls, bytewise_ms);
+
+        CHECK_EQ(pattern_found, NUM_FIELDS);
+        CHECK_EQ(bytewise_found, NUM_FIELDS);
+        CHECK(pattern_getters.calls * 10 < bytewise_getters.calls);
+        CHECK_EQ(pattern_getters.wild_reads + bytewise_getters.wild_reads, 0);
+    }
+}
+
+int main() {
+    test_layout();
+    compare_to_bytewise();
+
+    return test::result();
+}
@@ -0,0 +1,148 @@
+// utility::matrix_kernels (what re_pose runs on) against plain scalar loops, on a 200 joint skeleton.
+// Checks the results match before timing anything, exits non-zero if they don't.
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "utility/MatrixKernels.hpp"
+
+#include "Test.hpp"
+
+namespace kernels = utility::matrix_kernels;
+
+namespace {
+    constexpr int32_t NUM_JOINTS = 200;
+    constexpr int32_t ITERATIONS = 20000;
+    constexpr int32_t F = kernels::MATRIX_FLOATS;
+
+    namespace scalar {
+        void scale(float* mats, int32_t count, float s) {
+            for (int32_t i = 0; i < count; ++i) {
+                for (int32_t k = 0; k < 12; ++k) {
+                    mats[i * F + k] = s == 0.0f ? 0.0f : mats[i * F + k] * s;
+                }
+            }
+        }
+
+        void copy(float* dst, const float* src, int32_t count) {
+            for (int32_t i = 0; i < count * F; ++i) {
+                dst[i] = src[i];
+            }
+        }
+
+        void blend(float* dst, const float* a, const float* b, int32_t count, float t) {
+            for (int32_t i = 0; i < count * F; ++i) {
+                dst[i] = a[i] + (b[i] - a[i]) * t;
+            }
+        }
+
+        void multiply(float* mats, int32_t count, const float* root) {
+            for (int32_t i = 0; i < count; ++i) {
+                float result[F]{};
+                auto m = mats + i * F;
+
+                for (int32_t c = 0; c < 4; ++c) {
+                    for (int32_t r = 0; r < 4; ++r) {
+                        float sum = 0.0f;
+
+                        for (int32_t k = 0; k < 4; ++k) {
+                            sum += root[k * 4 + r] * m[c * 4 + k];
+                        }
+
+                        result[c * 4 + r] = sum;
+                    }
+                }
+
+                for (int32_t k = 0; k < F; ++k) {
+                    m[k] = result[k];
+                }
+            }
+        }
+    }
+
+    std::vector<float> make_pose(std::mt19937& rng) {
+        std::uniform_real_distribution<float> dist{ -2.0f, 2.0f };
+        std::vector<float> pose(NUM_JOINTS * F);
+
+        for (auto& f : pose) {
+            f = dist(rng);
+        }
+
+        return pose;
+    }
+
+    bool close(const std::vector<float>& a, const std::vector<float>& b) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::fabs(a[i] - b[i]) > 1e-4f * (1.0f + std::fabs(b[i]))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Runs both versions on the same input, checks they agree, then times them
+    template <typename Simd, typename Scalar>
+    void compare(const char* name, const std::vector<float>& input, Simd&& simd, Scalar&& reference) {
+        auto a = input;
+        auto b = input;
+        simd(a.data());
+        reference(b.data());
+
+        std::printf("%-10s", name);
+        CHECK(close(a, b));
+
+        // Run on the same buffer over and over, reset every so often so blends and multiplies don't blow up
+        auto run = [&](auto&& func) {
+            auto pose = input;
+
+            return test::time([&]() {
+                for (int32_t i = 0; i < ITERATIONS; ++i) {
+                    if ((i & 63) == 0) {
+                        kernels::copy(pose.data(), input.data(), NUM_JOINTS);
+                    }
+
+                    func(pose.data());
+                }
+            }) * 1e6 / ITERATIONS;
+        };
+
+        const auto simd_ns = run(simd);
+        const auto scalar_ns = run(reference);
+
+        std::printf("  sse: %8.1fns  scalar: %8.1fns  (%.2fx)\n", simd_ns, scalar_ns, scalar_ns / simd_ns);
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 34 };
+    const auto pose = make_pose(rng);
+    const auto target = make_pose(rng);
+    const auto root = make_pose(rng);
+    std::vector<float> saved(NUM_JOINTS * F);
+
+    std::printf("%d joints, per call:\n", NUM_JOINTS);
+
+    compare("scale(0)", pose,
+        [](float* m) { kernels::scale(m, NUM_JOINTS, 0.0f); },
+        [](float* m) { scalar::scale(m, NUM_JOINTS, 0.0f); });
+
+    compare("scale", pose,
+        [](float* m) { kernels::scale(m, NUM_JOINTS, 0.999f); },
+        [](float* m) { scalar::scale(m, NUM_JOINTS, 0.999f); });
+
+    compare("copy", pose,
+        [&](float* m) { kernels::copy(saved.data(), m, NUM_JOINTS); },
+        [&](float* m) { scalar::copy(saved.data(), m, NUM_JOINTS); });
+
+    compare("blend", pose,
+        [&](float* m) { kernels::blend(m, m, target.data(), NUM_JOINTS, 0.25f); },
+        [&](float* m) { scalar::blend(m, m, target.data(), NUM_JOINTS, 0.25f); });
+
+    compare("multiply", pose,
+        [&](float* m) { kernels::multiply(m, NUM_JOINTS, root.data()); },
+        [&](float* m) { scalar::multiply(m, NUM_JOINTS, root.data()); });
+
+    return test::result();
+}
@@ -0,0 +1,225 @@
+// utility::re_array::layout on hand built arrays: where elements are, how far apart, and what the views accept.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "sdk/REArrayLayout.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    namespace layout = utility::re_array::layout;
+
+    // Only the members the layout code reads, at the same offsets as REClassInfo
+    struct FakeClassInfo {
+        uint8_t pad_0[0x26];
+        uint8_t objectType;
+        uint8_t pad_27[0x5];
+        uint32_t elementSize;
+        uint32_t size;
+    };
+
+    // Same as REArrayBase (REManagedObject + containedType, num1, numElements)
+    struct FakeArray {
+        void* info;
+        uint32_t referenceCount;
+        uint8_t pad_C[4];
+        FakeClassInfo* containedType;
+        int32_t num1;
+        int32_t numElements;
+    };
+
+    static_assert(offsetof(FakeClassInfo, objectType) == 0x26);
+    static_assert(offsetof(FakeClassInfo, elementSize) == 0x2C);
+    static_assert(offsetof(FakeArray, containedType) == 0x10);
+    static_assert(offsetof(FakeArray, numElements) == 0x1C);
+    static_assert(sizeof(FakeArray) == 0x20);
+
+    struct Vec3 {
+        float x, y, z;
+    };
+
+    // An array object in a buffer. The data offset goes 8 bytes in front of what info points at,
+    // the elements get laid out by hand so the layout code can't agree with itself by accident.
+    class Synthetic {
+    public:
+        Synthetic(uint8_t object_type, uint32_t element_size, int32_t num_elements, int32_t data_offset = sizeof(FakeArray))
+            : m_info(2),
+            m_object((data_offset + (size_t)element_size * num_elements + 15) / 8)
+        {
+            const auto offset = (uint64_t)(uint32_t)data_offset;
+            memcpy(&m_info[0], &offset, sizeof(offset));
+
+            m_class.objectType = object_type;
+            m_class.elementSize = element_size;
+
+            auto array = get();
+            array->info = &m_info[1];
+            array->containedType = &m_class;
+            array->num1 = 1;
+            array->numElements = num_elements;
+
+            m_data_offset = data_offset;
+        }
+
+        FakeArray* get() {
+            return (FakeArray*)m_object.data();
+        }
+
+        uint8_t* data() {
+            return (uint8_t*)m_object.data() + m_data_offset;
+        }
+
+        FakeClassInfo& get_class() {
+            return m_class;
+        }
+
+    private:
+        std::vector<uint64_t> m_info;
+        std::vector<uint64_t> m_object;
+        FakeClassInfo m_class{};
+        int32_t m_data_offset{};
+    };
+
+    // A struct array whose elementSize is bigger than what's read out of each element,
+    // the stride has to come from the class info and not from sizeof(T)
+    void test_inline_stride() {
+        constexpr uint32_t STRIDE = 0x14;
+        constexpr int32_t COUNT = 7;
+
+        Synthetic array{ layout::VALUE_TYPE, STRIDE, COUNT };
+
+        for (int32_t i = 0; i < COUNT; ++i) {
+            const Vec3 v{ (float)i, (float)i * 2.0f, (float)i * 3.0f };
+            memcpy(array.data() + i * STRIDE, &v, sizeof(v));
+        }
+
+        CHECK(layout::has_inline_elements(array.get()));
+        CHECK_EQ(layout::get_element_size(array.get()), STRIDE);
+        CHECK(layout::get_data(array.get()) == array.data());
+
+        for (int32_t i = 0; i < COUNT; ++i) {
+            auto v = layout::get_inline_element<Vec3>(array.get(), i);
+
+            CHECK((uint8_t*)v == array.data() + i * STRIDE);
+            CHECK(v->x == (float)i && v->y == (float)i * 2.0f && v->z == (float)i * 3.0f);
+        }
+
+        // A view would step by sizeof(Vec3), so it's refused
+        CHECK(layout::get_inline_view<Vec3>(array.get()).empty());
+        CHECK(layout::get_ptr_view<void>(array.get()).empty());
+    }
+
+    void test_inline_view() {
+        constexpr int32_t COUNT = 5;
+
+        Synthetic array{ layout::VALUE_TYPE, sizeof(Vec3), COUNT };
+
+        for (int32_t i = 0; i < COUNT; ++i) {
+            const Vec3 v{ (float)i, 0.0f, -(float)i };
+            memcpy(array.data() + i * sizeof(Vec3), &v, sizeof(v));
+        }
+
+        auto view = layout::get_inline_view<Vec3>(array.get());
+        CHECK_EQ(view.size(), COUNT);
+        CHECK((uint8_t*)view.data() == array.data());
+
+        for (int32_t i = 0; i < COUNT; ++i) {
+            CHECK(&view[i] == layout::get_inline_element<Vec3>(array.get(), i));
+            CHECK(view[i].x == (float)i && view[i].z == -(float)i);
+        }
+
+        // Wrong T
+        CHECK(layout::get_inline_view<float>(array.get()).empty());
+        CHECK(layout::get_inline_view<uint64_t>(array.get()).empty());
+    }
+
+    void test_pointers() {
+        constexpr int32_t COUNT = 6;
+
+        int targets[COUNT]{};
+        Synthetic array{ 1, 0x40, COUNT }; // Object, elementSize is the class's and doesn't matter here
+
+        for (int32_t i = 0; i < COUNT; ++i) {
+            auto ptr = i == 3 ? nullptr : &targets[i];
+            memcpy(array.data() + i * sizeof(void*), &ptr, sizeof(ptr));
+        }
+
+        CHECK(!layout::has_inline_elements(array.get()));
+        CHECK_EQ(layout::get_element_size(array.get()), sizeof(void*));
+
+        auto view = layout::get_ptr_view<int>(array.get());
+        CHECK_EQ(view.size(), COUNT);
+
+        for (int32_t i = 0; i < COUNT; ++i) {
+            auto expected = i == 3 ? nullptr : &targets[i];
+
+            CHECK(layout::get_ptr_element<int>(array.get(), i) == expected);
+            CHECK(view[i] == expected);
+        }
+
+        CHECK(layout::get_inline_view<int*>(array.get()).empty());
+
+        // No element type at all is treated the same
+        array.get_class().objectType = layout::VALUE_TYPE;
+        array.get()->containedType = nullptr;
+
+        CHECK(!layout::has_inline_elements(array.get()));
+        CHECK_EQ(layout::get_element_size(array.get()), sizeof(void*));
+        CHECK_EQ(layout::get_ptr_view<int>(array.get()).size(), COUNT);
+    }
+
+    void test_bounds() {
+        Synthetic values{ layout::VALUE_TYPE, 4, 3 };
+        Synthetic pointers{ 1, 8, 3 };
+
+        for (auto idx : { -1, 3, 4, 0x7FFFFFFF, (int)0x80000000 }) {
+            CHECK(layout::get_inline_element<uint32_t>(values.get(), idx) == nullptr);
+            CHECK(layout::get_ptr_element<void>(pointers.get(), idx) == nullptr);
+        }
+
+        CHECK(layout::get_inline_element<uint32_t>(values.get(), 2) != nullptr);
+
+        Synthetic empty{ layout::VALUE_TYPE, 4, 0 };
+        CHECK(layout::get_inline_element<uint32_t>(empty.get(), 0) == nullptr);
+        CHECK(layout::get_inline_view<uint32_t>(empty.get()).empty());
+
+        // Garbage count
+        Synthetic negative{ 1, 8, 0 };
+        negative.get()->numElements = -5;
+        CHECK(layout::get_ptr_view<void>(negative.get()).empty());
+        CHECK(layout::get_ptr_element<void>(negative.get(), 0) == nullptr);
+
+        CHECK(layout::get_inline_view<uint32_t>((FakeArray*)nullptr).empty());
+        CHECK(layout::get_ptr_view<void>((FakeArray*)nullptr).empty());
+    }
+
+    // Multidimensional arrays keep their bounds in front of the elements, the offset in the info covers that
+    void test_data_offset() {
+        constexpr int32_t OFFSET = sizeof(FakeArray) + 4 * 2;
+
+        Synthetic array{ layout::VALUE_TYPE, 2, 4, OFFSET };
+        array.get()->num1 = 2;
+
+        for (uint16_t i = 0; i < 4; ++i) {
+            const uint16_t v = 0x100 + i;
+            memcpy(array.data() + i * 2, &v, sizeof(v));
+        }
+
+        CHECK((uint8_t*)layout::get_data(array.get()) == (uint8_t*)array.get() + OFFSET);
+        CHECK_EQ(*layout::get_inline_element<uint16_t>(array.get(), 3), 0x103);
+        CHECK_EQ(layout::get_inline_view<uint16_t>(array.get())[1], 0x101);
+    }
+}
+
+int main() {
+    test_inline_stride();
+    test_inline_view();
+    test_pointers();
+    test_bounds();
+    test_data_offset();
+
+    return test::result();
+}
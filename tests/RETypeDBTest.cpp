@@ -0,0 +1,386 @@
+// sdk::typedb::Writer out to memory and back through a View: every lookup against the vectors it was
+// written from, name hash collisions forced into the indices, and files View has to turn down.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "sdk/RETypeDB.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    using namespace sdk::typedb;
+
+    constexpr uint32_t NUM_TYPES = 400;
+    constexpr uint32_t NUM_ENUMS = 60;
+
+    // Few field names so most of them are declared on lots of types
+    const char* field_names[]{ "m_hp", "m_position", "m_owner", "m_flags", "m_speed", "m_target", "m_state", "m_id" };
+
+    Writer make_writer(std::mt19937& rng) {
+        Writer w{};
+
+        // Parents come before children, and a few roots
+        for (uint32_t i = 0; i < NUM_TYPES; ++i) {
+            const auto super = i < 3 || rng() % 20 == 0 ? NONE : (uint32_t)(rng() % i);
+            w.types.push_back(Type{ w.add_string("app.Type" + std::to_string(i)), super, 0x10 + i, (uint32_t)rng() });
+        }
+
+        for (uint32_t i = 0; i < NUM_TYPES; ++i) {
+            auto& t = w.types[i];
+
+            t.first_field = (uint32_t)w.fields.size();
+            t.num_fields = rng() % 4;
+
+            for (uint32_t j = 0; j < t.num_fields; ++j) {
+                const auto name = w.add_string(field_names[rng() % std::size(field_names)]);
+                w.fields.push_back(Field{ name, w.add_string("System.Int32"), i, (uint32_t)rng() % 32, (int32_t)(0x10 + j * 8) });
+            }
+
+            t.first_method = (uint32_t)w.methods.size();
+            t.num_methods = rng() % 3;
+
+            for (uint32_t j = 0; j < t.num_methods; ++j) {
+                w.methods.push_back(Method{ w.add_string("method" + std::to_string(j)), w.add_string("System.Void"), i, (uint32_t)w.params.size(), j });
+
+                for (uint32_t k = 0; k < j; ++k) {
+                    w.params.push_back(Param{ w.add_string("arg" + std::to_string(k)), w.add_string("System.Single"), 12 });
+                }
+            }
+        }
+
+        // Pre/post numbering, the same scheme as export_type_db
+        std::vector<std::vector<uint32_t>> children(NUM_TYPES);
+        uint32_t counter = 0;
+
+        for (uint32_t i = 0; i < NUM_TYPES; ++i) {
+            if (w.types[i].super != NONE) {
+                children[w.types[i].super].push_back(i);
+            }
+        }
+
+        std::function<void(uint32_t)> number = [&](uint32_t i) {
+            w.types[i].pre = counter++;
+
+            for (auto child : children[i]) {
+                number(child);
+            }
+
+            w.types[i].post = counter++;
+        };
+
+        for (uint32_t i = 0; i < NUM_TYPES; ++i) {
+            if (w.types[i].super == NONE) {
+                number(i);
+            }
+        }
+
+        // Enums sorted by name, values sorted and unique with the extremes in there
+        std::vector<std::string> enum_names{};
+
+        for (uint32_t i = 0; i < NUM_ENUMS; ++i) {
+            enum_names.push_back("app.Enum" + std::to_string(i));
+        }
+
+        std::sort(enum_names.begin(), enum_names.end());
+
+        for (auto& name : enum_names) {
+            std::vector<int64_t> values{};
+
+            for (auto n = rng() % 12; n > 0; --n) {
+                values.push_back((int64_t)(rng() % 64) - 16);
+            }
+
+            if (rng() % 4 == 0) {
+                values.push_back(std::numeric_limits<int64_t>::min());
+                values.push_back(std::numeric_limits<int64_t>::max());
+            }
+
+            std::sort(values.begin(), values.end());
+            values.erase(std::unique(values.begin(), values.end()), values.end());
+
+            w.enums.push_back(Enum{ w.add_string(name), (uint32_t)w.enum_values.size(), (uint32_t)values.size() });
+
+            for (auto value : values) {
+                w.enum_values.push_back(EnumValue{ value, w.add_string(name + "::V" + std::to_string(value)) });
+            }
+        }
+
+        return w;
+    }
+
+    std::string write(const Writer& w) {
+        std::ostringstream out{};
+        CHECK(w.write(out, 0x12345678));
+        return out.str();
+    }
+
+    Header get_header(const std::string& file) {
+        Header h{};
+        memcpy(&h, file.data(), sizeof(h));
+        return h;
+    }
+
+    // Patches element i of a section in a copy of the file
+    template <typename T, typename F>
+    std::string patch(std::string file, const Section& section, uint32_t i, F&& func) {
+        T element{};
+        const auto offset = section.offset + i * sizeof(T);
+
+        memcpy(&element, file.data() + offset, sizeof(T));
+        func(element);
+        memcpy(&file[offset], &element, sizeof(T));
+
+        return file;
+    }
+
+    // Rewrites a name index so every entry named from gets the hash of to, like a real FNV collision would
+    std::string collide(std::string file, const Section& section, std::string_view from, std::string_view to) {
+        std::vector<NameIndex> index(section.count);
+        memcpy(index.data(), file.data() + section.offset, index.size() * sizeof(NameIndex));
+
+        for (auto& n : index) {
+            n.hash = n.hash == hash(from) ? hash(to) : n.hash;
+        }
+
+        std::sort(index.begin(), index.end(), [](const NameIndex& a, const NameIndex& b) {
+            return a.hash != b.hash ? a.hash < b.hash : a.index < b.index;
+        });
+
+        memcpy(&file[section.offset], index.data(), index.size() * sizeof(NameIndex));
+        return file;
+    }
+
+    void test_strings(Writer& w) {
+        const auto a = w.add_string("app.Type0");
+        const auto b = w.add_string("app.Type0");
+
+        CHECK_EQ(a.offset, b.offset);
+        CHECK(w.get_string(a) == "app.Type0");
+    }
+
+    void test_round_trip(const Writer& w, const std::string& file) {
+        const View db{ file.data(), file.size() };
+
+        CHECK(db.valid());
+        CHECK_EQ(db.get_header().game_timestamp, 0x12345678);
+        CHECK_EQ(db.types().size, w.types.size());
+        CHECK_EQ(db.fields().size, w.fields.size());
+        CHECK_EQ(db.methods().size, w.methods.size());
+        CHECK_EQ(db.params().size, w.params.size());
+        CHECK_EQ(db.enums().size, w.enums.size());
+        CHECK_EQ(db.enum_values().size, w.enum_values.size());
+
+        for (uint32_t i = 0; i < w.types.size(); ++i) {
+            const auto name = w.get_string(w.types[i].name);
+            const auto t = db.find_type(name);
+
+            CHECK(t == &db.types()[i]);
+            CHECK(db.get_string(t->name) == name);
+            CHECK_EQ(t->size, w.types[i].size);
+            CHECK(db.get_super(*t) == (w.types[i].super != NONE ? &db.types()[w.types[i].super] : nullptr));
+
+            for (auto& m : db.methods(*t)) {
+                CHECK_EQ(m.declaring_type, i);
+                CHECK_EQ(db.params(m).size, m.num_params);
+
+                for (auto& p : db.params(m)) {
+                    CHECK(db.get_string(p.type_name) == "System.Single");
+                }
+            }
+        }
+
+        for (auto name : { "", "app.Type", "app.Type4000", "app.type1", "System.Int32" }) {
+            CHECK(db.find_type(name) == nullptr);
+        }
+
+        // Nearest declaration up the chain wins
+        for (uint32_t i = 0; i < w.types.size(); ++i) {
+            for (auto name : field_names) {
+                const Field* expected = nullptr;
+
+                for (auto t = i; t != NONE && expected == nullptr; t = w.types[t].super) {
+                    for (uint32_t f = w.types[t].first_field; f < w.types[t].first_field + w.types[t].num_fields; ++f) {
+                        if (w.get_string(w.fields[f].name) == name) {
+                            expected = &db.fields()[f];
+                            break;
+                        }
+                    }
+                }
+
+                CHECK(db.find_field(&db.types()[i], name) == expected);
+            }
+        }
+
+        for (auto name : field_names) {
+            std::vector<uint32_t> expected{};
+            std::vector<uint32_t> visited{};
+
+            for (uint32_t f = 0; f < w.fields.size(); ++f) {
+                if (w.get_string(w.fields[f].name) == name) {
+                    expected.push_back(f);
+                }
+            }
+
+            db.for_each_field_named(name, [&](const Field& f) { visited.push_back((uint32_t)(&f - db.fields().data)); });
+
+            CHECK(expected.size() > 1);
+            CHECK(visited == expected);
+        }
+    }
+
+    // Against walking up the super chain, every pair
+    void test_is_a(const Writer& w, const std::string& file) {
+        const View db{ file.data(), file.size() };
+
+        for (uint32_t i = 0; i < w.types.size(); ++i) {
+            for (uint32_t base = 0; base < w.types.size(); ++base) {
+                auto expected = false;
+
+                for (auto t = i; t != NONE && !expected; t = w.types[t].super) {
+                    expected = t == base;
+                }
+
+                CHECK(db.is_a(db.types()[i], db.types()[base]) == expected);
+            }
+        }
+    }
+
+    void test_enums(const Writer& w, const std::string& file) {
+        const View db{ file.data(), file.size() };
+
+        for (uint32_t i = 0; i < w.enums.size(); ++i) {
+            const auto name = w.get_string(w.enums[i].name);
+            const auto e = db.find_enum(name);
+
+            CHECK(e == &db.enums()[i]);
+
+            // Sorts right after name, before app.Enum10 when name is app.Enum1
+            CHECK(db.find_enum(std::string{ name } + "!") == nullptr);
+
+            for (int64_t value = -20; value < 50; ++value) {
+                const auto expected = std::find_if(db.values(*e).begin(), db.values(*e).end(), [&](const EnumValue& v) { return v.value == value; });
+                const auto found = db.get_enum_value_name(*e, value);
+
+                CHECK(found == (expected != db.values(*e).end() ? db.get_string(expected->name) : std::string_view{}));
+                CHECK(expected == db.values(*e).end() || found == std::string{ name } + "::V" + std::to_string(value));
+            }
+
+            for (auto& v : db.values(*e)) {
+                CHECK(db.get_enum_value_name(*e, v.value) == db.get_string(v.name));
+            }
+        }
+
+        CHECK(db.find_enum("") == nullptr);
+        CHECK(db.find_enum("app.Enum") == nullptr);
+        CHECK(db.find_enum("zzz") == nullptr);
+    }
+
+    // Same hash, different names: the walk has to go over every entry with the hash and compare names
+    void test_collisions(const Writer& w, const std::string& file) {
+        const auto h = get_header(file);
+
+        // app.Type1's entry takes app.Type300's hash. Lower index, so it sorts first in the run.
+        {
+            const auto collided = collide(file, h.type_names, "app.Type1", "app.Type300");
+            const View db{ collided.data(), collided.size() };
+
+            CHECK(db.valid());
+            CHECK(db.find_type("app.Type300") == &db.types()[300]);
+            CHECK(db.find_type("app.Type1") == nullptr); // its hash moved, the index really can't find it
+            CHECK(db.find_type("app.Type2") == &db.types()[2]);
+        }
+
+        // Every field named m_hp now hashes like m_id, both name runs are interleaved by index
+        {
+            const auto collided = collide(file, h.field_names, "m_hp", "m_id");
+            const View db{ collided.data(), collided.size() };
+
+            std::vector<uint32_t> expected{};
+            std::vector<uint32_t> visited{};
+
+            for (uint32_t f = 0; f < w.fields.size(); ++f) {
+                if (w.get_string(w.fields[f].name) == "m_id") {
+                    expected.push_back(f);
+                }
+            }
+
+            db.for_each_field_named("m_id", [&](const Field& f) { visited.push_back((uint32_t)(&f - db.fields().data)); });
+
+            CHECK(db.valid());
+            CHECK(visited == expected);
+        }
+
+        // Duplicate names, the first one wins
+        {
+            Writer dup{};
+            dup.types.push_back(Type{ dup.add_string("a"), NONE });
+            dup.types.push_back(Type{ dup.add_string("b"), NONE });
+            dup.types.push_back(Type{ dup.add_string("a"), NONE });
+
+            const auto out = write(dup);
+            const View db{ out.data(), out.size() };
+
+            CHECK(db.valid());
+            CHECK(db.find_type("a") == &db.types()[0]);
+            CHECK(db.find_type("b") == &db.types()[1]);
+        }
+    }
+
+    // Indices that would read outside the file, everything View trusts after valid()
+    void test_validate(const std::string& file) {
+        const auto h = get_header(file);
+
+        auto valid = [](const std::string& data, size_t size) {
+            return View{ data.data(), size }.valid();
+        };
+
+        CHECK(valid(file, file.size()));
+        CHECK(!View{}.valid());
+        CHECK(!valid(file, file.size() - 1));
+        CHECK(!valid(file, sizeof(Header) - 1));
+        CHECK(!valid(std::string(file.size(), '\0'), file.size()));
+
+        CHECK(!valid(patch<Header>(file, { 0, 1 }, 0, [](Header& x) { x.version = VERSION + 1; }), file.size()));
+        CHECK(!valid(patch<Header>(file, { 0, 1 }, 0, [&](Header& x) { x.types.count = file.size(); }), file.size()));
+
+        CHECK(!valid(patch<Field>(file, h.fields, 5, [&](Field& f) { f.declaring_type = (uint32_t)h.types.count; }), file.size()));
+        CHECK(!valid(patch<Method>(file, h.methods, 5, [&](Method& m) { m.declaring_type = NONE; }), file.size()));
+        CHECK(!valid(patch<Method>(file, h.methods, 5, [&](Method& m) { m.first_param = (uint32_t)h.params.count; m.num_params = 1; }), file.size()));
+        CHECK(!valid(patch<Type>(file, h.types, 7, [&](Type& t) { t.first_field = (uint32_t)h.fields.count; t.num_fields = 1; }), file.size()));
+        CHECK(!valid(patch<Enum>(file, h.enums, 3, [&](Enum& e) { e.num_values = (uint32_t)h.enum_values.count + 1; }), file.size()));
+        CHECK(!valid(patch<NameIndex>(file, h.type_names, 0, [&](NameIndex& n) { n.index = (uint32_t)h.types.count; }), file.size()));
+        CHECK(!valid(patch<NameIndex>(file, h.field_names, 0, [&](NameIndex& n) { n.index = (uint32_t)h.fields.count; }), file.size()));
+
+        // The terminator has to be in the table too
+        CHECK(!valid(patch<Type>(file, h.types, 0, [&](Type& t) { t.name = { (uint32_t)h.strings.count - 1, 1 }; }), file.size()));
+        CHECK(!valid(patch<Param>(file, h.params, 0, [&](Param& p) { p.type_name.length = 0xFFFFFFFF; }), file.size()));
+        CHECK(!valid(patch<EnumValue>(file, h.enum_values, 0, [&](EnumValue& v) { v.name.offset = (uint32_t)h.strings.count; }), file.size()));
+
+        // In range isn't an error
+        CHECK(valid(patch<Field>(file, h.fields, 5, [&](Field& f) { f.declaring_type = (uint32_t)h.types.count - 1; }), file.size()));
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 48 };
+
+    auto w = make_writer(rng);
+    const auto file = write(w);
+
+    test_strings(w);
+    test_round_trip(w, file);
+    test_is_a(w, file);
+    test_enums(w, file);
+    test_collisions(w, file);
+    test_validate(file);
+
+    return test::result();
+}
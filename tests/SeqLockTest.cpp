@@ -0,0 +1,164 @@
+// utility::SeqLock under contention: readers never see a torn value, update() never loses a write.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "utility/SeqLock.hpp"
+
+#include "Test.hpp"
+
+namespace {
+    // Every field always holds the same number, anything else is a torn read.
+    // Big enough that a copy isn't a single instruction.
+    struct State {
+        uint64_t values[16];
+
+        bool consistent() const {
+            for (auto v : values) {
+                if (v != values[0]) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    State make_state(uint64_t v) {
+        State state{};
+
+        for (auto& value : state.values) {
+            value = v;
+        }
+
+        return state;
+    }
+
+    // Several threads incrementing through update(), like on_update_camera_controller2 does
+    void test_update_contention() {
+        constexpr size_t NUM_WRITERS = 4;
+        constexpr size_t NUM_READERS = 2;
+        constexpr uint64_t INCREMENTS = 100000;
+
+        utility::SeqLock<State> lock{ make_state(0) };
+        std::atomic<bool> done{ false };
+        std::atomic<size_t> torn{ 0 };
+        std::atomic<size_t> reads{ 0 };
+        std::vector<std::thread> threads{};
+
+        for (size_t i = 0; i < NUM_READERS; ++i) {
+            threads.emplace_back([&]() {
+                uint64_t last = 0;
+
+                while (!done.load()) {
+                    const auto state = lock.load();
+
+                    // Torn, or went backwards
+                    if (!state.consistent() || state.values[0] < last) {
+                        ++torn;
+                    }
+
+                    last = state.values[0];
+                    ++reads;
+                }
+            });
+        }
+
+        std::vector<std::thread> writers{};
+
+        for (size_t i = 0; i < NUM_WRITERS; ++i) {
+            writers.emplace_back([&]() {
+                for (uint64_t n = 0; n < INCREMENTS; ++n) {
+                    lock.update([](State state) {
+                        for (auto& value : state.values) {
+                            ++value;
+                        }
+
+                        return state;
+                    });
+                }
+            });
+        }
+
+        for (auto& writer : writers) {
+            writer.join();
+        }
+
+        done = true;
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        const auto final_state = lock.load();
+
+        std::printf("update: %zu writers x %llu increments, %zu reads\n", NUM_WRITERS, (unsigned long long)INCREMENTS, reads.load());
+
+        CHECK(final_state.consistent());
+        CHECK_EQ(final_state.values[0], NUM_WRITERS * INCREMENTS);
+        CHECK_EQ(torn.load(), 0);
+    }
+
+    // update() racing store(), like the camera controller callback racing update_camera_transform.
+    // Stores write odd numbers, updates add 2, so whatever is read has to be consistent and updates
+    // must never be applied on top of a value that got replaced halfway through.
+    void test_update_and_store() {
+        constexpr uint64_t ITERATIONS = 100000;
+
+        utility::SeqLock<State> lock{ make_state(1) };
+        std::atomic<size_t> torn{ 0 };
+        std::atomic<size_t> wrong_parity{ 0 };
+
+        std::thread updater{ [&]() {
+            for (uint64_t n = 0; n < ITERATIONS; ++n) {
+                lock.update([&](State state) {
+                    if (!state.consistent()) {
+                        ++torn;
+                    }
+
+                    for (auto& value : state.values) {
+                        value += 2;
+                    }
+
+                    return state;
+                });
+            }
+        } };
+
+        std::thread storer{ [&]() {
+            for (uint64_t n = 0; n < ITERATIONS; ++n) {
+                lock.store(make_state(n * 2 + 1));
+            }
+        } };
+
+        std::thread reader{ [&]() {
+            for (uint64_t n = 0; n < ITERATIONS; ++n) {
+                const auto state = lock.load();
+
+                if (!state.consistent()) {
+                    ++torn;
+                }
+
+                if ((state.values[0] & 1) == 0) {
+                    ++wrong_parity;
+                }
+            }
+        } };
+
+        updater.join();
+        storer.join();
+        reader.join();
+
+        CHECK(lock.load().consistent());
+        CHECK_EQ(torn.load(), 0);
+        CHECK_EQ(wrong_parity.load(), 0);
+    }
+}
+
+int main() {
+    test_update_contention();
+    test_update_and_store();
+
+    return test::result();
+}
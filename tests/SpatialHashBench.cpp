@@ -0,0 +1,69 @@
+// utility::SpatialHash build and query times from 10k to 100k items, against checking every item.
+
+#include <random>
+#include <vector>
+
+#include "Test.hpp"
+#include "SpatialHashUtil.hpp"
+
+int main() {
+    constexpr int32_t NUM_QUERIES = 1000;
+
+    std::mt19937 rng{ 37 };
+
+    std::printf("%8s %8s %10s %22s %22s\n", "items", "spread", "build", "radius 20 (grid/all)", "frustum (grid/all)");
+
+    // Spread over a bigger level as the count goes up, and everything crowded into a 200m box
+    for (auto crowded : { false, true })
+    for (size_t count : { 10000, 25000, 50000, 100000 }) {
+        const auto extent = crowded ? 100.0f : 500.0f * std::cbrt(count / 10000.0f);
+        const auto items = make_items(rng, count, extent);
+
+        Grid grid{ 5.0f };
+        const auto build_ms = test::time([&]() { grid.build(items); });
+
+        std::vector<std::array<float, 3>> centers{};
+        std::vector<Grid::Frustum> frustums{};
+        std::uniform_real_distribution<float> pos{ -extent, extent };
+
+        for (auto i = 0; i < NUM_QUERIES; ++i) {
+            centers.push_back({ pos(rng), pos(rng), pos(rng) });
+            frustums.push_back(make_frustum(rng, extent));
+        }
+
+        size_t found = 0;
+        size_t brute_found = 0;
+
+        const auto radius_ms = test::time([&]() {
+            for (auto& c : centers) {
+                grid.query_radius(c[0], c[1], c[2], 20.0f, [&](const Grid::Item&) { ++found; });
+            }
+        });
+
+        const auto radius_brute_ms = test::time([&]() {
+            for (auto& c : centers) {
+                brute_found += brute_radius(items, c[0], c[1], c[2], 20.0f).size();
+            }
+        });
+
+        const auto frustum_ms = test::time([&]() {
+            for (auto& f : frustums) {
+                grid.query_frustum(f, [&](const Grid::Item&) { ++found; });
+            }
+        });
+
+        const auto frustum_brute_ms = test::time([&]() {
+            for (auto& f : frustums) {
+                brute_found += brute_frustum(items, f).size();
+            }
+        });
+
+        CHECK_EQ(found, brute_found);
+
+        std::printf("%8zu %7.0fm %8.2fms %9.1fus / %7.1fus %9.1fus / %7.1fus\n", count, extent * 2.0f, build_ms,
+            radius_ms * 1000.0 / NUM_QUERIES, radius_brute_ms * 1000.0 / NUM_QUERIES,
+            frustum_ms * 1000.0 / NUM_QUERIES, frustum_brute_ms * 1000.0 / NUM_QUERIES);
+    }
+
+    return test::result();
+}
@@ -0,0 +1,114 @@
+// utility::SpatialHash queries against brute force, and what it does with positions that aren't sane.
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "utility/SpatialHash.hpp"
+
+#include "Test.hpp"
+#include "SpatialHashUtil.hpp"
+
+namespace {
+    void test_radius(std::mt19937& rng) {
+        auto items = make_items(rng, 20000, 500.0f);
+        Grid grid{ 5.0f };
+        grid.build(items);
+
+        std::uniform_real_distribution<float> pos{ -600.0f, 600.0f };
+        std::uniform_real_distribution<float> radius{ 0.0f, 80.0f };
+
+        for (auto i = 0; i < 200; ++i) {
+            const float x = pos(rng), y = pos(rng), z = pos(rng), r = i == 0 ? 5000.0f : radius(rng);
+
+            std::vector<uint32_t> found{};
+            grid.query_radius(x, y, z, r, [&](const Grid::Item& item) { found.push_back(item.value); });
+
+            CHECK(sorted(found) == brute_radius(items, x, y, z, r));
+        }
+    }
+
+    void test_frustum(std::mt19937& rng) {
+        auto items = make_items(rng, 20000, 500.0f);
+        Grid grid{ 5.0f };
+        grid.build(items);
+
+        for (auto i = 0; i < 200; ++i) {
+            const auto frustum = make_frustum(rng, 500.0f);
+
+            std::vector<uint32_t> found{};
+            grid.query_frustum(frustum, [&](const Grid::Item& item) { found.push_back(item.value); });
+
+            CHECK(sorted(found) == brute_frustum(items, frustum));
+        }
+
+        // Crowded, with short frustums, so the cells in the box get walked instead of checking every item
+        auto crowd = make_items(rng, 20000, 100.0f);
+        Grid crowd_grid{ 5.0f };
+        crowd_grid.build(crowd);
+
+        for (auto i = 0; i < 200; ++i) {
+            const auto frustum = make_frustum(rng, 100.0f, 30.0f);
+
+            std::vector<uint32_t> found{};
+            crowd_grid.query_frustum(frustum, [&](const Grid::Item& item) { found.push_back(item.value); });
+
+            CHECK(sorted(found) == brute_frustum(crowd, frustum));
+        }
+
+        // No far plane, the corners can't be worked out so every item gets checked
+        auto infinite = make_frustum(rng, 500.0f);
+        infinite[5] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+        std::vector<uint32_t> found{};
+        grid.query_frustum(infinite, [&](const Grid::Item& item) { found.push_back(item.value); });
+
+        CHECK(sorted(found) == brute_frustum(items, infinite));
+        CHECK(!found.empty());
+    }
+
+    void test_bad_positions() {
+        constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+        constexpr auto inf = std::numeric_limits<float>::infinity();
+
+        std::vector<Grid::Item> items{
+            { 1.0f, 2.0f, 3.0f, 0 },
+            { nan, 0.0f, 0.0f, 1 },
+            { 0.0f, inf, 0.0f, 2 },
+            { 0.0f, 0.0f, -inf, 3 },
+            { 1e30f, -1e30f, 1e30f, 4 },
+            { -4.0f, 0.0f, 0.0f, 5 },
+        };
+
+        Grid grid{ 5.0f };
+        grid.build(items);
+
+        CHECK_EQ(grid.size(), 3);
+
+        std::vector<uint32_t> found{};
+        grid.query_radius(0.0f, 0.0f, 0.0f, 10.0f, [&](const Grid::Item& item) { found.push_back(item.value); });
+        CHECK(sorted(found) == (std::vector<uint32_t>{ 0, 5 }));
+
+        // Way out there, still gets found
+        found.clear();
+        grid.query_radius(1e30f, -1e30f, 1e30f, 1.0f, [&](const Grid::Item& item) { found.push_back(item.value); });
+        CHECK(found == (std::vector<uint32_t>{ 4 }));
+
+        // Garbage queries find nothing instead of doing anything undefined
+        found.clear();
+        grid.query_radius(nan, 0.0f, 0.0f, 10.0f, [&](const Grid::Item& item) { found.push_back(item.value); });
+        grid.query_radius(0.0f, 0.0f, 0.0f, nan, [&](const Grid::Item& item) { found.push_back(item.value); });
+        CHECK(found.empty());
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 37 };
+
+    test_radius(rng);
+    test_frustum(rng);
+    test_bad_positions();
+
+    return test::result();
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "utility/SpatialHash.hpp"
+
+// Shared by the SpatialHash test and benchmark
+using Grid = utility::SpatialHash<uint32_t>;
+
+inline std::vector<Grid::Item> make_items(std::mt19937& rng, size_t count, float extent) {
+    std::uniform_real_distribution<float> pos{ -extent, extent };
+    std::vector<Grid::Item> items{};
+    items.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        items.push_back({ pos(rng), pos(rng), pos(rng), (uint32_t)i });
+    }
+
+    return items;
+}
+
+// A perspective frustum somewhere in the box looking in a random direction, 90 degrees wide
+inline Grid::Frustum make_frustum(std::mt19937& rng, float extent, float far_z = 200.0f) {
+    std::uniform_real_distribution<float> pos{ -extent, extent };
+    std::uniform_real_distribution<float> dir{ -1.0f, 1.0f };
+
+    auto normalize = [](std::array<float, 3> v) {
+        const auto length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        return std::array<float, 3>{ v[0] / length, v[1] / length, v[2] / length };
+    };
+
+    auto cross = [](const std::array<float, 3>& a, const std::array<float, 3>& b) {
+        return std::array<float, 3>{ a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+    };
+
+    const std::array<float, 3> c{ pos(rng), pos(rng), pos(rng) };
+    const auto f = normalize({ dir(rng), dir(rng), dir(rng) });
+    const auto r = normalize(cross(f, { 0.0f, 1.0f, 0.0f }));
+    const auto u = cross(r, f);
+    const auto t = 1.0f;
+    const auto near_z = 0.1f;
+
+    // normal . (p - c) + offset >= 0 inside
+    auto plane = [&](std::array<float, 3> n, float offset) {
+        return Grid::Plane{ n[0], n[1], n[2], -(n[0] * c[0] + n[1] * c[1] + n[2] * c[2]) + offset };
+    };
+
+    auto add = [](std::array<float, 3> a, std::array<float, 3> b, float s) {
+        return std::array<float, 3>{ a[0] + b[0] * s, a[1] + b[1] * s, a[2] + b[2] * s };
+    };
+
+    return {
+        plane(add(r, f, t), 0.0f),                  // left
+        plane(add({ -r[0], -r[1], -r[2] }, f, t), 0.0f), // right
+        plane(add(u, f, t), 0.0f),                  // bottom
+        plane(add({ -u[0], -u[1], -u[2] }, f, t), 0.0f), // top
+        plane(f, -near_z),                          // near
+        plane({ -f[0], -f[1], -f[2] }, far_z),      // far
+    };
+}
+
+inline std::vector<uint32_t> sorted(std::vector<uint32_t> v) {
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+inline std::vector<uint32_t> brute_radius(const std::vector<Grid::Item>& items, float x, float y, float z, float radius) {
+    std::vector<uint32_t> out{};
+
+    for (auto& item : items) {
+        const auto dx = item.x - x, dy = item.y - y, dz = item.z - z;
+
+        if (dx * dx + dy * dy + dz * dz <= radius * radius) {
+            out.push_back(item.value);
+        }
+    }
+
+    return out;
+}
+
+inline std::vector<uint32_t> brute_frustum(const std::vector<Grid::Item>& items, const Grid::Frustum& frustum) {
+    std::vector<uint32_t> out{};
+
+    for (auto& item : items) {
+        bool inside = true;
+
+        for (auto& p : frustum) {
+            if (p[0] * item.x + p[1] * item.y + p[2] * item.z + p[3] < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+
+        if (inside) {
+            out.push_back(item.value);
+        }
+    }
+
+    return out;
+}
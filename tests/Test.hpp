@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// Just enough to fail a ctest run with a useful message.
+namespace test {
+    inline int g_failures = 0;
+
+    inline int result() {
+        if (g_failures > 0) {
+            std::printf("%d check(s) failed\n", g_failures);
+            return 1;
+        }
+
+        std::printf("All checks passed\n");
+        return 0;
+    }
+
+    // Milliseconds func takes to run
+    template <typename F>
+    double time(F&& func) {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ++test::g_failures; \
+        } \
+    } while (false)
+
+// Integers only
+#define CHECK_EQ(a, b) \
+    do { \
+        const auto check_a_ = (long long)(a); \
+        const auto check_b_ = (long long)(b); \
+        if (check_a_ != check_b_) { \
+            std::printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld vs %lld\n", __FILE__, __LINE__, #a, #b, check_a_, check_b_); \
+            ++test::g_failures; \
+        } \
+    } while (false)
@@ -0,0 +1,90 @@
+// utility::TrigramIndex on 50k+ synthetic type names: cold queries through a capped Search (what the
+// "Type Name" box does), typing a query one character at a time, and the old find-on-every-name loop.
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utility/TrigramIndex.hpp"
+
+#include "Test.hpp"
+#include "TypeNameUtil.hpp"
+
+namespace {
+    constexpr size_t MAX_RESULTS = 256;
+    constexpr int REPEATS = 20;
+
+    // ms per query, best of REPEATS so a stray context switch doesn't count
+    template <typename F>
+    double best_of(F&& func) {
+        auto best = 1e9;
+
+        for (auto i = 0; i < REPEATS; ++i) {
+            best = std::min(best, test::time(func));
+        }
+
+        return best;
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 44 };
+    size_t sink = 0;
+
+    for (size_t count : { 50000, 100000 }) {
+        const auto names = make_type_names(rng, count);
+        const std::vector<std::string_view> views{ names.begin(), names.end() };
+
+        utility::TrigramIndex index{};
+        const auto build_ms = test::time([&]() { index = utility::TrigramIndex{ views }; });
+
+        std::printf("%zu names, built in %.1f ms\n", count, build_ms);
+        std::printf("%-20s %8s %10s %10s\n", "query", "matches", "index ms", "find ms");
+
+        for (auto query : { "a", "ap", "app", "camera", "CameraController", "ropeway.enemy", "List`1<via", "zzzz", "camrea" }) {
+            size_t matches = 0;
+
+            const auto index_ms = best_of([&]() {
+                utility::TrigramIndex::Search search{ MAX_RESULTS };
+                search.update(index, query);
+                matches = search.get_results().size();
+                sink += matches;
+            });
+
+            // What the box did before the index, case sensitive and unranked
+            const auto find_ms = best_of([&]() {
+                for (auto& name : names) {
+                    sink += name.find(query) != std::string::npos;
+                }
+            });
+
+            std::printf("%-20s %8zu %10.3f %10.3f\n", query, matches, index_ms, find_ms);
+        }
+
+        // One keystroke at a time, the worst single keystroke is what the UI feels
+        for (std::string_view typed : { "cameracontroller", "app.ropeway.gimmick" }) {
+            auto worst = 0.0;
+            auto total = 0.0;
+
+            for (auto repeat = 0; repeat < REPEATS; ++repeat) {
+                utility::TrigramIndex::Search search{ MAX_RESULTS };
+
+                for (size_t i = 1; i <= typed.size(); ++i) {
+                    const auto ms = test::time([&]() { search.update(index, typed.substr(0, i)); });
+
+                    worst = repeat == 0 ? std::max(worst, ms) : worst;
+                    total += ms;
+                }
+
+                sink += search.get_results().size();
+            }
+
+            std::printf("typing \"%.*s\": %.3f ms per keystroke, worst %.3f ms\n", (int)typed.size(), typed.data(), total / REPEATS / typed.size(), worst);
+        }
+    }
+
+    std::printf("(%zu)\n", sink);
+
+    return 0;
+}
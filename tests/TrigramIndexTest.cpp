@@ -0,0 +1,299 @@
+// utility::TrigramIndex against a brute force lowercase find over every name: the full match set,
+// the ranked top of it, fuzzy fallbacks, a capped Search narrowing as a query gets typed, and cancelling.
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utility/TrigramIndex.hpp"
+
+#include "Test.hpp"
+#include "TypeNameUtil.hpp"
+
+namespace {
+    using Match = utility::TrigramIndex::Match;
+
+    std::string to_lower(std::string_view s) {
+        std::string out{ s };
+
+        for (auto& c : out) {
+            c = c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+        }
+
+        return out;
+    }
+
+    struct Reference {
+        const std::vector<std::string>* names;
+        std::vector<std::string> lowered{};
+
+        Reference(const std::vector<std::string>& names)
+            : names{ &names }
+        {
+            for (auto& name : names) {
+                lowered.push_back(to_lower(name));
+            }
+        }
+
+        std::vector<Match> match(std::string_view query) const {
+            std::vector<Match> out{};
+            const auto q = to_lower(query);
+
+            if (q.empty()) {
+                return out;
+            }
+
+            for (uint32_t id = 0; id < lowered.size(); ++id) {
+                auto& name = lowered[id];
+
+                if (name.find(q) == std::string::npos) {
+                    continue;
+                }
+
+                const auto dot = name.rfind('.');
+                auto score = 100;
+
+                if (name == q) {
+                    score = 1000;
+                }
+                else if (dot != std::string::npos && name.compare(dot + 1, q.size(), q) == 0) {
+                    score = 500;
+                }
+                else if (name.compare(0, q.size(), q) == 0) {
+                    score = 300;
+                }
+
+                out.push_back({ id, score });
+            }
+
+            return out;
+        }
+
+        // Names with at least half of the query's distinct trigrams
+        std::vector<Match> match_fuzzy(std::string_view query) const {
+            std::vector<std::string> trigrams{};
+            const auto q = to_lower(query);
+
+            for (size_t i = 0; i + 3 <= q.size(); ++i) {
+                trigrams.push_back(q.substr(i, 3));
+            }
+
+            std::sort(trigrams.begin(), trigrams.end());
+            trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+            std::vector<Match> out{};
+
+            if (trigrams.empty()) {
+                return out;
+            }
+
+            const auto threshold = std::max<size_t>(1, (trigrams.size() + 1) / 2);
+
+            for (uint32_t id = 0; id < lowered.size(); ++id) {
+                size_t count = 0;
+
+                for (auto& trigram : trigrams) {
+                    count += lowered[id].find(trigram) != std::string::npos;
+                }
+
+                if (count >= threshold) {
+                    out.push_back({ id, (int32_t)(count * 100 / trigrams.size()) });
+                }
+            }
+
+            return out;
+        }
+
+        // Best score, then shortest, then alphabetical
+        std::vector<Match> rank(std::vector<Match> matches, size_t max_results) const {
+            std::sort(matches.begin(), matches.end(), [&](const Match& a, const Match& b) {
+                auto& a_name = (*names)[a.id];
+                auto& b_name = (*names)[b.id];
+
+                if (a.score != b.score) {
+                    return a.score > b.score;
+                }
+
+                return a_name.size() != b_name.size() ? a_name.size() < b_name.size() : a_name < b_name;
+            });
+
+            matches.resize(std::min(matches.size(), max_results));
+            return matches;
+        }
+    };
+
+    bool same(const std::vector<Match>& a, const std::vector<Match>& b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const Match& x, const Match& y) {
+            return x.id == y.id && x.score == y.score;
+        });
+    }
+
+    bool same_set(std::vector<Match> a, std::vector<Match> b) {
+        auto by_id = [](const Match& x, const Match& y) { return x.id < y.id; };
+
+        std::sort(a.begin(), a.end(), by_id);
+        std::sort(b.begin(), b.end(), by_id);
+
+        return same(a, b);
+    }
+
+    std::vector<std::string> make_names(std::mt19937& rng) {
+        auto names = make_type_names(rng, 20000);
+
+        // Edge cases: shorter than a trigram, no namespace, exact duplicates of queries, odd characters
+        for (auto name : { "A", "ab", "x.y", "Camera", "via.Camera", "app.camera.CAMERA", "System.Collections.Generic.List`1<via.Camera>", "a.b.c.d" }) {
+            // Names are unique, like the type list's, otherwise ties have no right order
+            if (std::find(names.begin(), names.end(), name) == names.end()) {
+                names.push_back(name);
+            }
+        }
+
+        std::shuffle(names.begin(), names.end(), rng);
+        return names;
+    }
+
+    // Pieces of real names with their case scrambled, plus things that won't be there
+    std::vector<std::string> make_queries(std::mt19937& rng, const std::vector<std::string>& names) {
+        std::vector<std::string> queries{ "a", "A", "ap", "app", "camera", "CAMERA", "ropeway.enemy", ".", "`1<", "zzzz", "q", "xyzzy", "a.b" };
+
+        for (auto i = 0; i < 300; ++i) {
+            auto& name = names[rng() % names.size()];
+            const auto length = 1 + rng() % std::min<size_t>(name.size(), 14);
+            auto query = name.substr(rng() % (name.size() - length + 1), length);
+
+            for (auto& c : query) {
+                if (rng() % 3 == 0) {
+                    c = c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c;
+                }
+            }
+
+            queries.push_back(query);
+        }
+
+        return queries;
+    }
+
+    void test_find(const utility::TrigramIndex& index, const Reference& reference, const std::vector<std::string>& queries) {
+        for (auto& query : queries) {
+            const auto expected = reference.match(query);
+
+            std::vector<Match> matches{};
+            CHECK(index.match(query, matches));
+            CHECK(same_set(matches, expected));
+
+            std::vector<Match> found{};
+
+            for (size_t max_results : { (size_t)1, (size_t)10, (size_t)256, SIZE_MAX }) {
+                CHECK(index.find(query, found, max_results));
+                CHECK(same(found, reference.rank(expected, max_results)));
+            }
+
+            // Narrowing a superset gives the same thing as going to the index
+            std::vector<Match> narrowed{};
+            CHECK(index.match(query, narrowed, &expected));
+            CHECK(same_set(narrowed, expected));
+
+            const auto broader = reference.match(query.substr(0, (query.size() + 1) / 2));
+            CHECK(index.match(query, narrowed, &broader));
+            CHECK(same_set(narrowed, expected));
+        }
+
+        std::vector<Match> out{ { 1, 1 } };
+        CHECK(index.match("", out));
+        CHECK(out.empty());
+        CHECK(index.match(std::string_view{ "a\0b", 3 }, out));
+        CHECK(out.empty());
+    }
+
+    void test_fuzzy(const utility::TrigramIndex& index, const Reference& reference) {
+        for (auto query : { "camrea", "contorller", "ropway.enemy", "Playre", "sweetlihgt", "qqqqqq" }) {
+            std::vector<Match> found{};
+
+            CHECK(index.find_fuzzy(query, found, 256));
+            CHECK(same(found, reference.rank(reference.match_fuzzy(query), 256)));
+        }
+    }
+
+    // Typing one character at a time, deleting, and pasting something else, through a capped search.
+    // Every step has to come out the same as a fresh query, however much the last one got cut off.
+    void test_search(std::mt19937& rng, const utility::TrigramIndex& index, const Reference& reference, const std::vector<std::string>& queries) {
+        constexpr size_t MAX_RESULTS = 256;
+
+        utility::TrigramIndex::Search search{ MAX_RESULTS };
+
+        auto check_step = [&](std::string_view query) {
+            CHECK(search.update(index, query));
+
+            auto expected = reference.match(query);
+            auto fuzzy = false;
+
+            if (expected.empty() && query.size() >= 3) {
+                expected = reference.match_fuzzy(query);
+                fuzzy = true;
+            }
+
+            CHECK(search.is_fuzzy() == fuzzy);
+            CHECK_EQ(search.get_num_matches(), expected.size());
+            CHECK(same(search.get_results(), reference.rank(expected, MAX_RESULTS)));
+        };
+
+        for (std::string typed : { "app.ropeway.gimmick.action", "via.camera", "System.Collections.Generic.List`1<app", "acamera", "camrea.controller" }) {
+            for (size_t i = 1; i <= typed.size(); ++i) {
+                check_step(typed.substr(0, i));
+            }
+
+            for (size_t i = typed.size(); i > 0; --i) {
+                check_step(typed.substr(0, i - 1));
+            }
+        }
+
+        for (auto i = 0; i < 100; ++i) {
+            auto& query = queries[rng() % queries.size()];
+            check_step(query);
+            check_step(query + query.substr(0, 1));
+        }
+    }
+
+    void test_cancel(const utility::TrigramIndex& index) {
+        std::atomic<bool> cancel{ true };
+        std::vector<Match> out{};
+
+        // Checked before the first name, so any query that gets as far as its names stops
+        CHECK(!index.match("a", out, nullptr, &cancel));
+        CHECK(!index.find("camera", out, 256, nullptr, &cancel));
+
+        utility::TrigramIndex::Search search{ 256 };
+        CHECK(search.update(index, "camera"));
+
+        const auto before = search.get_results();
+
+        CHECK(!before.empty());
+        CHECK(!search.update(index, "cameracontroller", &cancel));
+        CHECK(same(search.get_results(), before));
+
+        // Not cancelled, and the cancelled query didn't count as the last one
+        cancel = false;
+        CHECK(search.update(index, "cameracontroller", &cancel));
+        CHECK(!same(search.get_results(), before));
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 44 };
+
+    const auto names = make_names(rng);
+    const std::vector<std::string_view> views{ names.begin(), names.end() };
+    const utility::TrigramIndex index{ views };
+    const Reference reference{ names };
+    const auto queries = make_queries(rng, names);
+
+    test_find(index, reference, queries);
+    test_fuzzy(index, reference);
+    test_search(rng, index, reference, queries);
+    test_cancel(index);
+
+    return test::result();
+}
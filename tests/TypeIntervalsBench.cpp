@@ -0,0 +1,79 @@
+// utility::TypeIntervals is_a against walking the super chain (by pointer, and by name with strcmp)
+// on a synthetic tree of 50k types.
+
+#include <random>
+#include <vector>
+
+#include "utility/TypeIntervals.hpp"
+
+#include "Test.hpp"
+#include "TypeTreeUtil.hpp"
+
+int main() {
+    constexpr size_t NUM_QUERIES = 2000000;
+
+    std::mt19937 rng{ 31 };
+
+    auto tree = make_type_tree(rng, 50000, 500);
+    auto types = tree.get_types();
+
+    utility::TypeIntervals<FakeType*> intervals{};
+    const auto build_ms = test::time([&]() { intervals = utility::TypeIntervals<FakeType*>{ types, get_parent }; });
+
+    std::uniform_int_distribution<size_t> pick{ 0, types.size() - 1 };
+
+    // Half random pairs (mostly a miss, full walk to the root), half checks against a real ancestor
+    std::vector<std::pair<FakeType*, FakeType*>> queries{};
+
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        auto t = types[pick(rng)];
+        auto base = types[pick(rng)];
+
+        if (i % 2 == 0) {
+            size_t depth = 0;
+
+            for (auto parent = t; parent != nullptr; parent = parent->super) {
+                ++depth;
+            }
+
+            base = t;
+
+            for (auto steps = rng() % depth; steps > 0; --steps) {
+                base = base->super;
+            }
+        }
+
+        queries.emplace_back(t, base);
+    }
+
+    size_t interval_hits = 0;
+    size_t chain_hits = 0;
+    size_t name_hits = 0;
+
+    const auto interval_ms = test::time([&]() {
+        for (auto& [t, base] : queries) {
+            interval_hits += intervals.is_a(t, base) == 1;
+        }
+    });
+
+    const auto chain_ms = test::time([&]() {
+        for (auto& [t, base] : queries) {
+            chain_hits += chain_is_a(t, base);
+        }
+    });
+
+    const auto name_ms = test::time([&]() {
+        for (auto& [t, base] : queries) {
+            name_hits += chain_is_a(t, base->name);
+        }
+    });
+
+    const auto ns = [&](double ms) { return ms * 1e6 / NUM_QUERIES; };
+
+    std::printf("%zu types, built in %.1f ms\n", intervals.size(), build_ms);
+    std::printf("%-24s %8.1f ns/query (%zu hits)\n", "intervals", ns(interval_ms), interval_hits);
+    std::printf("%-24s %8.1f ns/query (%zu hits)\n", "super chain, pointer", ns(chain_ms), chain_hits);
+    std::printf("%-24s %8.1f ns/query (%zu hits)\n", "super chain, strcmp", ns(name_ms), name_hits);
+
+    return interval_hits == chain_hits && chain_hits == name_hits ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+// utility::TypeIntervals against walking the parent chain, on a synthetic type tree.
+
+#include <random>
+#include <vector>
+
+#include "utility/TypeIntervals.hpp"
+
+#include "Test.hpp"
+#include "TypeTreeUtil.hpp"
+
+namespace {
+    using Intervals = utility::TypeIntervals<FakeType*>;
+
+    void test_against_chain(std::mt19937& rng) {
+        auto tree = make_type_tree(rng, 20000, 300);
+        auto types = tree.get_types();
+
+        Intervals intervals{ types, get_parent };
+        CHECK_EQ(intervals.size(), types.size());
+
+        std::uniform_int_distribution<size_t> pick{ 0, types.size() - 1 };
+
+        // Random pairs are almost always unrelated
+        for (auto i = 0; i < 200000; ++i) {
+            auto t = types[pick(rng)];
+            auto base = types[pick(rng)];
+
+            CHECK_EQ(intervals.is_a(t, base), chain_is_a(t, base) ? 1 : 0);
+        }
+
+        // So also every ancestor of some types, and their siblings
+        for (auto i = 0; i < 2000; ++i) {
+            auto t = types[pick(rng)];
+
+            for (auto base = t; base != nullptr; base = base->super) {
+                CHECK_EQ(intervals.is_a(t, base), 1);
+                CHECK_EQ(intervals.is_a(base, t), base == t ? 1 : 0);
+            }
+        }
+
+        // The end of the chain is below every link of it
+        auto last = types.back();
+
+        for (size_t i = types.size() - 300; i < types.size(); ++i) {
+            CHECK_EQ(intervals.is_a(last, types[i]), 1);
+        }
+    }
+
+    void test_missing() {
+        FakeType root{ "root", nullptr };
+        FakeType middle{ "middle", &root };
+        FakeType leaf{ "leaf", &middle };
+        FakeType other{ "other", nullptr };
+
+        // Parents get pulled in even when only the leaf is listed
+        Intervals intervals{ { &leaf }, get_parent };
+
+        CHECK_EQ(intervals.size(), 3);
+        CHECK(intervals.contains(&root) && intervals.contains(&middle));
+        CHECK_EQ(intervals.is_a(&leaf, &root), 1);
+        CHECK_EQ(intervals.is_a(&middle, &leaf), 0);
+
+        // Not in the table, the caller has to fall back
+        CHECK_EQ(intervals.is_a(&other, &root), -1);
+        CHECK_EQ(intervals.is_a(&leaf, &other), -1);
+        CHECK_EQ(intervals.is_a(nullptr, &root), -1);
+
+        Intervals empty{};
+        CHECK_EQ(empty.is_a(&leaf, &root), -1);
+
+        // Duplicates and nulls in the list
+        Intervals duplicates{ { &leaf, nullptr, &leaf, &middle, &other }, get_parent };
+        CHECK_EQ(duplicates.size(), 4);
+        CHECK_EQ(duplicates.is_a(&other, &other), 1);
+        CHECK_EQ(duplicates.is_a(&leaf, &other), 0);
+    }
+}
+
+int main() {
+    std::mt19937 rng{ 31 };
+
+    test_against_chain(rng);
+    test_missing();
+
+    return test::result();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// Type names shaped like the engine's: dotted namespaces, CamelCase names glued together from a
+// small vocabulary, nested types ("+"), generic instantiations, and the odd duplicate-ish name.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+inline std::vector<std::string> make_type_names(std::mt19937& rng, size_t count) {
+    static const char* namespaces[]{
+        "app.ropeway", "app.ropeway.camera", "app.ropeway.enemy", "app.ropeway.enemy.em0000", "app.ropeway.enemy.em3000",
+        "app.ropeway.gimmick.action", "app.ropeway.gui", "app.ropeway.survivor", "app.ropeway.survivor.player",
+        "app.ropeway.weapon.shell", "app.ropeway.timeline", "via", "via.motion", "via.render", "via.physics",
+        "via.effect", "via.gui", "via.navigation", "System", "System.Collections.Generic", "System.Reflection",
+    };
+
+    static const char* words[]{
+        "Camera", "Controller", "Manager", "Player", "Action", "Gimmick", "Motion", "Render", "Shell", "Param",
+        "Context", "Info", "Data", "Settings", "Light", "Sweet", "Post", "Effect", "Tone", "Mapping", "Enemy",
+        "Damage", "Hit", "Collider", "Joint", "Transform", "Game", "Object", "Behavior", "Tree", "Node", "Event",
+        "Sound", "Fsm", "State", "Input", "Pad", "Mouse", "Aim", "Weapon", "Equip", "Item", "Inventory", "Map",
+        "Door", "Area", "Scene", "Load", "Task", "Job", "Timer", "Curve", "Ik", "Leg", "Arm", "Head", "Look", "At",
+    };
+
+    std::vector<std::string> names{};
+    names.reserve(count);
+
+    std::uniform_int_distribution<size_t> pick_namespace{ 0, std::size(namespaces) - 1 };
+    std::uniform_int_distribution<size_t> pick_word{ 0, std::size(words) - 1 };
+
+    auto make_name = [&]() {
+        std::string name{};
+
+        for (auto n = 1 + rng() % 4; n > 0; --n) {
+            name += words[pick_word(rng)];
+        }
+
+        return name;
+    };
+
+    while (names.size() < count) {
+        auto name = std::string{ namespaces[pick_namespace(rng)] } + "." + make_name();
+
+        switch (rng() % 10) {
+        case 0:
+            name += "+" + make_name();
+            break;
+        case 1:
+            name = "System.Collections.Generic.List`1<" + name + ">";
+            break;
+        case 2:
+            name += std::to_string(rng() % 1000);
+            break;
+        default:
+            break;
+        }
+
+        names.push_back(std::move(name));
+    }
+
+    // The type list has every name once
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    for (size_t i = 0; names.size() < count; ++i) {
+        names.push_back("app.ropeway.Generated" + std::to_string(i));
+    }
+
+    return names;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+// A synthetic type tree shaped like the engine's: a few roots, most types a handful of levels deep,
+// one long chain, and names like "app.ropeway.Type123".
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+struct FakeType {
+    const char* name;
+    FakeType* super;
+};
+
+struct TypeTree {
+    std::vector<std::unique_ptr<FakeType>> types{};
+    std::vector<std::string> names{};
+
+    std::vector<FakeType*> get_types() const {
+        std::vector<FakeType*> result{};
+
+        for (auto& t : types) {
+            result.push_back(t.get());
+        }
+
+        return result;
+    }
+};
+
+inline FakeType* get_parent(FakeType* t) {
+    return t->super;
+}
+
+// Mostly a random recursive tree (depth grows with log n), the last chain_length types hang off each other
+inline TypeTree make_type_tree(std::mt19937& rng, size_t count, size_t chain_length = 200) {
+    TypeTree tree{};
+    tree.names.reserve(count);
+    tree.types.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        tree.names.push_back("app.ropeway.Type" + std::to_string(i));
+
+        FakeType* super = nullptr;
+
+        if (i + chain_length >= count && i > 0) {
+            super = tree.types[i - 1].get();
+        }
+        else if (i >= 4) {
+            super = tree.types[rng() % i].get();
+        }
+
+        tree.types.push_back(std::make_unique<FakeType>(FakeType{ nullptr, super }));
+    }
+
+    // names doesn't move anymore
+    for (size_t i = 0; i < count; ++i) {
+        tree.types[i]->name = tree.names[i].c_str();
+    }
+
+    return tree;
+}
+
+// What is_a did before the table, and still does for types it doesn't know
+inline bool chain_is_a(FakeType* t, FakeType* base) {
+    for (; t != nullptr; t = t->super) {
+        if (t == base) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Going by name, like re_managed_object::is_a(obj, name) without a resolved type
+inline bool chain_is_a(FakeType* t, const char* base_name) {
+    for (; t != nullptr && t->name != nullptr; t = t->super) {
+        if (std::strcmp(t->name, base_name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sdk/RETypeDB.hpp"
+
+// A type database snapshot mapped read-only, queried through get_view().
+class MappedTypeDB {
+public:
+    MappedTypeDB(const std::string& path) {
+        auto fd = open(path.c_str(), O_RDONLY);
+
+        if (fd == -1) {
+            return;
+        }
+
+        struct stat st{};
+
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            auto data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (data != MAP_FAILED) {
+                m_data = data;
+                m_size = (size_t)st.st_size;
+                m_view = sdk::typedb::View{ m_data, m_size };
+            }
+        }
+
+        // The mapping keeps the file alive
+        close(fd);
+    }
+
+    MappedTypeDB(const MappedTypeDB&) = delete;
+    MappedTypeDB& operator=(const MappedTypeDB&) = delete;
+
+    ~MappedTypeDB() {
+        if (m_data != nullptr) {
+            munmap(m_data, m_size);
+        }
+    }
+
+    // False if the file couldn't be mapped or isn't a snapshot this version understands
+    bool valid() const {
+        return m_view.valid();
+    }
+
+    const sdk::typedb::View& get_view() const {
+        return m_view;
+    }
+
+private:
+    void* m_data{ nullptr };
+    size_t m_size{ 0 };
+    sdk::typedb::View m_view{};
+};
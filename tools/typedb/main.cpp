@@ -0,0 +1,150 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "MappedTypeDB.hpp"
+
+using namespace sdk::typedb;
+
+static void usage() {
+    printf("usage: typedb <file> <command> [args]\n"
+        "  info                   header and section sizes\n"
+        "  type <name>            parents, size, fields and methods of a type\n"
+        "  field <name>           every type that declares a field with this name\n"
+        "  search <text>          types whose name contains text\n"
+        "  isa <type> <base>      whether type derives from base\n"
+        "  enum <name> [value]    values of an enum, or the name of one value\n");
+}
+
+static const Type* find_type_or_complain(const View& db, std::string_view name) {
+    auto t = db.find_type(name);
+
+    if (t == nullptr) {
+        printf("no type named %.*s\n", (int)name.size(), name.data());
+    }
+
+    return t;
+}
+
+static void print_type(const View& db, const Type& t) {
+    auto name = db.get_string(t.name);
+    printf("%.*s\n  size: 0x%x\n  crc: 0x%08x\n", (int)name.size(), name.data(), t.size, t.type_crc);
+
+    for (auto super = db.get_super(t); super != nullptr; super = db.get_super(*super)) {
+        auto super_name = db.get_string(super->name);
+        printf("  : %.*s\n", (int)super_name.size(), super_name.data());
+    }
+
+    for (auto& f : db.fields(t)) {
+        auto field_name = db.get_string(f.name);
+        auto type_name = db.get_string(f.type_name);
+
+        if (f.offset >= 0) {
+            printf("  [0x%04x] %.*s %.*s\n", f.offset, (int)type_name.size(), type_name.data(), (int)field_name.size(), field_name.data());
+        }
+        else {
+            printf("  [  ?   ] %.*s %.*s\n", (int)type_name.size(), type_name.data(), (int)field_name.size(), field_name.data());
+        }
+    }
+
+    for (auto& m : db.methods(t)) {
+        auto method_name = db.get_string(m.name);
+        auto return_type = db.get_string(m.return_type);
+        printf("  %.*s %.*s(", (int)return_type.size(), return_type.data(), (int)method_name.size(), method_name.data());
+
+        auto first = true;
+
+        for (auto& p : db.params(m)) {
+            auto param_name = db.get_string(p.name);
+            auto type_name = db.get_string(p.type_name);
+            printf("%s%.*s %.*s", first ? "" : ", ", (int)type_name.size(), type_name.data(), (int)param_name.size(), param_name.data());
+            first = false;
+        }
+
+        printf(")\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 1;
+    }
+
+    MappedTypeDB file{ argv[1] };
+
+    if (!file.valid()) {
+        printf("%s isn't a type database (or it's from a different version)\n", argv[1]);
+        return 1;
+    }
+
+    auto& db = file.get_view();
+    std::string_view command{ argv[2] };
+
+    if (command == "info") {
+        auto& h = db.get_header();
+        printf("version: %u\ngame timestamp: 0x%08x\ntypes: %u\nfields: %u\nmethods: %u\nparams: %u\nenums: %u\nenum values: %u\nstrings: %llu bytes\n",
+            h.version, h.game_timestamp, db.types().size, db.fields().size, db.methods().size, db.params().size,
+            db.enums().size, db.enum_values().size, (unsigned long long)h.strings.count);
+    }
+    else if (command == "type" && argc >= 4) {
+        if (auto t = find_type_or_complain(db, argv[3])) {
+            print_type(db, *t);
+        }
+    }
+    else if (command == "field" && argc >= 4) {
+        db.for_each_field_named(argv[3], [&](const Field& f) {
+            auto type_name = db.get_string(db.types()[f.declaring_type].name);
+            auto field_type = db.get_string(f.type_name);
+            printf("%.*s (%.*s) offset %d\n", (int)type_name.size(), type_name.data(), (int)field_type.size(), field_type.data(), f.offset);
+        });
+    }
+    else if (command == "search" && argc >= 4) {
+        std::string_view text{ argv[3] };
+
+        for (auto& t : db.types()) {
+            if (auto name = db.get_string(t.name); name.find(text) != std::string_view::npos) {
+                printf("%.*s\n", (int)name.size(), name.data());
+            }
+        }
+    }
+    else if (command == "isa" && argc >= 5) {
+        auto t = find_type_or_complain(db, argv[3]);
+        auto base = find_type_or_complain(db, argv[4]);
+
+        if (t == nullptr || base == nullptr) {
+            return 1;
+        }
+
+        const auto result = db.is_a(*t, *base);
+        printf("%s\n", result ? "yes" : "no");
+
+        return result ? 0 : 2;
+    }
+    else if (command == "enum" && argc >= 4) {
+        auto e = db.find_enum(argv[3]);
+
+        if (e == nullptr) {
+            printf("no enum named %s\n", argv[3]);
+            return 1;
+        }
+
+        if (argc >= 5) {
+            auto name = db.get_enum_value_name(*e, strtoll(argv[4], nullptr, 0));
+            printf("%.*s\n", (int)name.size(), name.data());
+        }
+        else {
+            for (auto& v : db.values(*e)) {
+                auto name = db.get_string(v.name);
+                printf("  %.*s = %lld\n", (int)name.size(), name.data(), (long long)v.value);
+            }
+        }
+    }
+    else {
+        usage();
+        return 1;
+    }
+
+    return 0;
+}